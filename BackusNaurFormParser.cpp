@@ -1,228 +1,236 @@
 #include "BackusNaurFormParser.h"
-#include <QStringList>
 
-QList<BackusNaurFormRule> BackusNaurFormParser::parse(QString &sourceString)
+/*!
+ * This function used to check that substring is at index and ends before endIndex.
+ *
+ * @param[in] string String.
+ * @param[in] index Index of first character of substring.
+ * @param[in] endIndex Index of end of checked part of string.
+ * @param[in] substring ASCII substring.
+ * @return Is substring at index.
+ */
+static bool IsSubstringAt(const QString &string, int index, int endIndex, const char *substring)
 {
-    deleteComments(sourceString);
+    for (; *substring != '\0'; index++, substring++) {
+        if ((index >= endIndex) || (string.at(index).unicode() != static_cast<ushort>(*substring)))
+            return false;
+    }
+    return true;
+}
 
-    QStringList rulesStringList = sourceString.split("\n");
+static bool IsLatinLetter(QChar character)
+{
+    ushort code = character.unicode();
+    return ((code >= 'a') && (code <= 'z')) || ((code >= 'A') && (code <= 'Z'));
+}
+
+QList<BackusNaurFormRule> BackusNaurFormParser::parse(const QString &sourceString)
+{
     QList<BackusNaurFormRule> rulesList;
-    foreach (QString ruleString, rulesStringList) {
-        if (!ruleString.isEmpty()) {
-            rulesList << parseRule(ruleString);
+    int index = 0;
+    while (index < sourceString.length()) {
+        int separatorIndex = -1;
+        bool isEmpty = true;
+        int ruleEndIndex = findRuleEndIndex(sourceString, index, separatorIndex, isEmpty);
+        if (!isEmpty) {
+
+            // rules in BackusNaur files
+            // <left> ::= <right1> <right2> <right3> ...
+
+            if (separatorIndex < 0) {
+                rulesList << BackusNaurFormRule();
+            } else {
+                rulesList << BackusNaurFormRule(parseLeftPart(sourceString, index, separatorIndex),
+                                                parseRightPart(sourceString, separatorIndex + 3, ruleEndIndex));
+            }
         }
+        index = ruleEndIndex + 1;
     }
     return rulesList;
 }
 
-void BackusNaurFormParser::deleteComments(QString &oldString)
+int BackusNaurFormParser::findRuleEndIndex(const QString &string, int index, int &separatorIndex, bool &isEmpty)
 {
-    int beginCommentIndex = findCommentBeginIndex(oldString, 0);
-    while (beginCommentIndex != -1) {
-        int endCommentIndex = findCommentEndIndex(oldString, beginCommentIndex + 2);
-        if (endCommentIndex != -1) {
-            oldString.remove(beginCommentIndex, endCommentIndex - beginCommentIndex + 2);
+    const int length = string.length();
+    while ((index < length) && (string.at(index) != QChar('\n'))) {
+        if (isCommentBegin(string, index)) {
+            index = findCommentEndIndex(string, index);
+            continue;
         }
-        beginCommentIndex = findCommentBeginIndex(oldString, 0);
+        if ((separatorIndex < 0) && IsSubstringAt(string, index, length, "::="))
+            separatorIndex = index;
+        isEmpty = false;
+        index++;
     }
+    return index;
 }
 
-int BackusNaurFormParser::findCommentBeginIndex(const QString &string, int startIndex)
+bool BackusNaurFormParser::isCommentBegin(const QString &string, int index)
 {
 
     // /* comments in BackusNaur files */
 
-    int beginCommentIndex = string.indexOf("/*", startIndex);
-    if (beginCommentIndex > 0) {
-        if (!string.mid(beginCommentIndex - 1, 1).contains("\"")) {
-            return beginCommentIndex;
-        }
-        return findCommentBeginIndex(string, beginCommentIndex + 2);
-    } else {
-        return beginCommentIndex;
-    }
+    // "/*" after quote is part of terminal symbol
+    return IsSubstringAt(string, index, string.length(), "/*")
+            && ((index == 0) || (string.at(index - 1) != QChar('"')));
 }
 
-int BackusNaurFormParser::findCommentEndIndex(const QString &string, int startIndex)
+int BackusNaurFormParser::findCommentEndIndex(const QString &string, int index)
 {
-    int endCommentIndex = string.indexOf("*/", startIndex);
-    if (endCommentIndex > 0) {
-        if (!string.mid(endCommentIndex - 1, 1).contains("\"")) {
-            return endCommentIndex;
-        }
-        return findCommentBeginIndex(string, endCommentIndex + 2);
-    } else {
-        return endCommentIndex;
-    }
+    // Comment without end lasts to end of text
+    int endCommentIndex = string.indexOf("*/", index + 2);
+    while ((endCommentIndex > 0) && (string.at(endCommentIndex - 1) == QChar('"')))
+        endCommentIndex = string.indexOf("*/", endCommentIndex + 2);
+    return (endCommentIndex < 0) ? string.length() : endCommentIndex + 2;
 }
 
-BackusNaurFormRule BackusNaurFormParser::parseRule(const QString &ruleSourceString)
+int BackusNaurFormParser::nextCharIndex(const QString &string, int index, int endIndex)
 {
+    index++;
+    while ((index < endIndex) && isCommentBegin(string, index))
+        index = findCommentEndIndex(string, index);
+    return qMin(index, endIndex);
+}
 
-    // rules in BackusNaur files
-    // <left> ::= <right1> <right2> <right3> ...
-
-    int separatorIndex = ruleSourceString.indexOf("::=");
-
-    if (separatorIndex < 0) {
-        return BackusNaurFormRule();
+int BackusNaurFormParser::skipWhitespaces(const QString &string, int index, int endIndex)
+{
+    while (index < endIndex) {
+        if ((string.at(index) == QChar(' ')) || (string.at(index) == QChar('\t')))
+            index++;
+        else if (isCommentBegin(string, index))
+            index = findCommentEndIndex(string, index);
+        else
+            break;
     }
-    SyntacticSymbol leftPart = parseLeftPart(ruleSourceString.mid(0, separatorIndex));
-    QList <SyntacticSymbol> rightPart = parseRightPart(ruleSourceString.mid(separatorIndex + 3));
-    return BackusNaurFormRule(leftPart, rightPart);
+    return qMin(index, endIndex);
 }
 
-SyntacticSymbol BackusNaurFormParser::parseLeftPart(QString leftPartString)
+SyntacticSymbol BackusNaurFormParser::parseLeftPart(const QString &string, int index, int endIndex)
 {
-    DeleteWhitespaceAtBegin(leftPartString);
-    if (leftPartString.indexOf("S") == 0)
+    index = skipWhitespaces(string, index, endIndex);
+    if (IsSubstringAt(string, index, endIndex, "S"))
         return SyntacticSymbol("S", SyntacticSymbol::START_SYMBOL, Token::NONE_CATEGORY);
 
-    return getNonterminalSymbol(leftPartString);
+    return getNonterminalSymbol(string, index, endIndex);
 }
 
-QList<SyntacticSymbol> BackusNaurFormParser::parseRightPart(QString rightPartSourceString)
+QList<SyntacticSymbol> BackusNaurFormParser::parseRightPart(const QString &string, int index, int endIndex)
 {
     QList<SyntacticSymbol> rightPart;
-    while(!rightPartSourceString.isEmpty()) {
-        DeleteWhitespaceAtBegin(rightPartSourceString);
+    while (true) {
+        index = skipWhitespaces(string, index, endIndex);
+        if (index >= endIndex)
+            return rightPart;
 
-        // If lambda-rule than return empty list
-        if (rightPartSourceString.indexOf("lambda") == 0)
+        // If lambda-rule than rest of rule is not read
+        if (IsSubstringAt(string, index, endIndex, "lambda"))
             return rightPart;
 
         SyntacticSymbol currentSymbol;
-        if (rightPartSourceString.indexOf("<") == 0) {
-            currentSymbol = getNonterminalSymbol(rightPartSourceString);
-        } else if (rightPartSourceString.indexOf("\"") == 0) {
-            currentSymbol = getTerminalSymbol(rightPartSourceString);
-        } else if (rightPartSourceString.indexOf("number") == 0) {
+        if (string.at(index) == QChar('<')) {
+            currentSymbol = getNonterminalSymbol(string, index, endIndex);
+        } else if (string.at(index) == QChar('"')) {
+            currentSymbol = getTerminalSymbol(string, index, endIndex);
+        } else if (IsSubstringAt(string, index, endIndex, "number")) {
             currentSymbol = SyntacticSymbol ("number",      SyntacticSymbol::TERMINAL_SYMBOL, Token::NUMBER_LITERAL_CATEGORY);
-        } else if (rightPartSourceString.indexOf("id") == 0) {
+            index += 6;
+        } else if (IsSubstringAt(string, index, endIndex, "id")) {
             currentSymbol = SyntacticSymbol ("id",          SyntacticSymbol::TERMINAL_SYMBOL, Token::IDENTIFIER_CATEGORY);
-        } else if (rightPartSourceString.indexOf("linefeed") == 0) {
+            index += 2;
+        } else if (IsSubstringAt(string, index, endIndex, "linefeed")) {
             currentSymbol = SyntacticSymbol ("linefeed",    SyntacticSymbol::TERMINAL_SYMBOL, Token::LINE_FEED_CATEGORY);
-        } else if (rightPartSourceString.indexOf("literal") == 0) {
+            index += 8;
+        } else if (IsSubstringAt(string, index, endIndex, "literal")) {
             currentSymbol = SyntacticSymbol ("literal",     SyntacticSymbol::TERMINAL_SYMBOL, Token::STRING_LITERAL_CATEGORY);
+            index += 7;
+        } else {
+            // Unknown characters are skipped by two
+            index = nextCharIndex(string, nextCharIndex(string, index, endIndex), endIndex);
         }
-        AppendListByCorrectItem(rightPart, currentSymbol);
-
-        rightPartSourceString.remove(0, GetSyntacticSymbolNameLengthWithBrackets(currentSymbol));
+        if (currentSymbol.isCorrect())
+            rightPart.append(currentSymbol);
     }
-    return rightPart;
 }
 
-SyntacticSymbol BackusNaurFormParser::getNonterminalSymbol(QString &string)
+SyntacticSymbol BackusNaurFormParser::getNonterminalSymbol(const QString &string, int &index, int endIndex)
 {
-    int currentCharIndex = -1;
-    int state = 0;
-    while (currentCharIndex < string.length()) {
-        currentCharIndex ++;
-        QString currentChar = string.mid(currentCharIndex, 1);
-        switch (state) {
-        case 0: {
-            if (currentChar.contains("<")) {
-                state = 1;
-            } else {
-                return SyntacticSymbol();
-            }
-            break;
-        }
-        case 1: {
-            if (!currentChar.contains(QRegExp("[<>]"))) {
-                state = 2;
-            } else {
-                string.remove(0, currentCharIndex);
-                return SyntacticSymbol();
-            }
-            break;
-        }
-        case 2: {
-            if (currentChar.contains(">")) {
-                SyntacticSymbol nonterminal = SyntacticSymbol (string.mid(1, currentCharIndex - 1),
-                                                               SyntacticSymbol::NONTERMINAL_SYMBOL,
-                                                               Token::NONE_CATEGORY);
-                return nonterminal;
-            } else if (currentChar.contains("<")) {
-                string.remove(0, currentCharIndex);
-                return SyntacticSymbol();
-            }
-            break;
-        }
-        default:
+    // Name is not empty and has no angle brackets
+    if (!IsSubstringAt(string, index, endIndex, "<"))
+        return SyntacticSymbol();
+
+    int currentCharIndex = nextCharIndex(string, index, endIndex);
+    if ((currentCharIndex < endIndex)
+            && ((string.at(currentCharIndex) == QChar('<')) || (string.at(currentCharIndex) == QChar('>')))) {
+        index = nextCharIndex(string, nextCharIndex(string, currentCharIndex, endIndex), endIndex);
+        return SyntacticSymbol();
+    }
+
+    while (currentCharIndex < endIndex) {
+        currentCharIndex = nextCharIndex(string, currentCharIndex, endIndex);
+        if (currentCharIndex >= endIndex)
             break;
+        if (string.at(currentCharIndex) == QChar('>')) {
+            SyntacticSymbol nonterminal = SyntacticSymbol (getSymbolName(string, index + 1, currentCharIndex),
+                                                           SyntacticSymbol::NONTERMINAL_SYMBOL,
+                                                           Token::NONE_CATEGORY);
+            index = currentCharIndex + 1;
+            return nonterminal;
+        } else if (string.at(currentCharIndex) == QChar('<')) {
+            index = nextCharIndex(string, nextCharIndex(string, currentCharIndex, endIndex), endIndex);
+            return SyntacticSymbol();
         }
     }
+    index = nextCharIndex(string, nextCharIndex(string, index, endIndex), endIndex);
     return SyntacticSymbol();
 }
 
-SyntacticSymbol BackusNaurFormParser::getTerminalSymbol(QString &string)
+SyntacticSymbol BackusNaurFormParser::getTerminalSymbol(const QString &string, int &index, int endIndex)
 {
-    int currentCharIndex = -1;
-    int state = 0;
-    while (currentCharIndex < string.length()) {
-        currentCharIndex ++;
-        QString currentChar = string.mid(currentCharIndex, 1);
-        switch (state) {
-        case 0: {
-            if (currentChar.contains("\"")) {
-                state = 1;
-            } else {
-                string.remove(0, currentCharIndex);
-                return SyntacticSymbol();
-            }
-            break;
-        }
-        case 1: {
-            if (!currentChar.contains("\"")) {
-                state = 2;
-            } else {
-                string.remove(0, currentCharIndex);
-                return SyntacticSymbol();
-            }
+    // Name is not empty and has no quotes
+    int currentCharIndex = nextCharIndex(string, index, endIndex);
+    if ((currentCharIndex >= endIndex) || (string.at(currentCharIndex) == QChar('"'))) {
+        index = nextCharIndex(string, nextCharIndex(string, currentCharIndex, endIndex), endIndex);
+        return SyntacticSymbol();
+    }
+
+    const QChar firstChar = string.at(currentCharIndex);
+    while (currentCharIndex < endIndex) {
+        currentCharIndex = nextCharIndex(string, currentCharIndex, endIndex);
+        if (currentCharIndex >= endIndex)
             break;
-        }
-        case 2: {
-            if (currentChar.contains("\"")) {
-                SyntacticSymbol terminal = SyntacticSymbol (string.mid(1, currentCharIndex - 1),
-                                                            SyntacticSymbol::TERMINAL_SYMBOL,
-                                                            Token::KEYWORD_CATEGORY);
-                if (!string.mid(1,1).contains(QRegExp("[a-zA-Z]"))) {
-                    terminal.setCategory(Token::CHAR_TOKEN_CATEGORY);
-                }
-                return terminal;
+        if (string.at(currentCharIndex) == QChar('"')) {
+            SyntacticSymbol terminal = SyntacticSymbol (getSymbolName(string, index + 1, currentCharIndex),
+                                                        SyntacticSymbol::TERMINAL_SYMBOL,
+                                                        Token::KEYWORD_CATEGORY);
+            if (!IsLatinLetter(firstChar)) {
+                terminal.setCategory(Token::CHAR_TOKEN_CATEGORY);
             }
-            break;
-        }
-        default:
-            break;
+            index = currentCharIndex + 1;
+            return terminal;
         }
     }
-    string.remove(0,currentCharIndex);
+    index = endIndex;
     return SyntacticSymbol();
 }
 
-void DeleteWhitespaceAtBegin(QString &string)
-{
-    while (string.mid(0,1).contains(QRegExp("[ \t]")))
-        string.remove(0,1);
-}
-
-void AppendListByCorrectItem(QList<SyntacticSymbol> &list, const SyntacticSymbol &item)
-{
-    if (item.isCorrect())
-        list.append(item);
-}
-
-int GetSyntacticSymbolNameLengthWithBrackets(const SyntacticSymbol &symbol)
+QString BackusNaurFormParser::getSymbolName(const QString &string, int index, int endIndex)
 {
-    int symbolNameLength = symbol.name().length();
-    if (symbol.category() == Token::KEYWORD_CATEGORY) {
-        symbolNameLength += 2;
-    } else if (symbol.category() == Token::CHAR_TOKEN_CATEGORY) {
-        symbolNameLength += 2;
-    } else if (symbol.type() == SyntacticSymbol::NONTERMINAL_SYMBOL) {
-        symbolNameLength += 2;
+    // Comments are rare in names, so name is copied by parts only if it has them
+    int commentBeginIndex = index;
+    while ((commentBeginIndex < endIndex) && !isCommentBegin(string, commentBeginIndex))
+        commentBeginIndex++;
+    if (commentBeginIndex == endIndex)
+        return string.mid(index, endIndex - index);
+
+    QString name = string.mid(index, commentBeginIndex - index);
+    index = findCommentEndIndex(string, commentBeginIndex);
+    while (index < endIndex) {
+        if (isCommentBegin(string, index)) {
+            index = findCommentEndIndex(string, index);
+        } else {
+            name += string.at(index);
+            index++;
+        }
     }
-    return symbolNameLength;
+    return name;
 }
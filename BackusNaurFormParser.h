@@ -14,32 +14,70 @@
 #include <QList>
 #include <QString>
 
+/*!
+ * @brief This class used to read production rules from text of .rules file.
+ *
+ * Text is scanned once from begin to end and it is not changed. Each line is one rule, comments are skipped
+ * between symbols and in names of symbols, comment which contains line feed joins lines. Comment can't split
+ * "::=" or names of predefined terminals (e.g. linefeed). Symbols are read in place by indexes, so only names
+ * of symbols are copied.
+ */
 class BackusNaurFormParser
 {
 
 public:
 
-    static QList <BackusNaurFormRule> parse(QString &sourceString);
+    /*!
+     * This method used to read production rules.
+     *
+     * @param[in] sourceString Text of rules file.
+     * @return Rules in order of lines. Rule of not empty line without "::=" has incorrect symbols.
+     */
+    static QList <BackusNaurFormRule> parse(const QString &sourceString);
 
 private:
 
-    static BackusNaurFormRule parseRule(const QString &ruleString);
+    /*!
+     * This method used to find end of rule which begins at index.
+     *
+     * @param[in] string Text of rules file.
+     * @param[in] index Index of first character of rule.
+     * @param[out] separatorIndex Index of first "::=" of rule or -1.
+     * @param[out] isEmpty Has rule only comments.
+     * @return Index of line feed which ends rule or length of text.
+     */
+    static int findRuleEndIndex(const QString &string, int index, int &separatorIndex, bool &isEmpty);
 
-    static SyntacticSymbol parseLeftPart(QString leftPartString);
-    static QList <SyntacticSymbol> parseRightPart(QString rightPartString);
+    static SyntacticSymbol parseLeftPart(const QString &string, int index, int endIndex);
+    static QList <SyntacticSymbol> parseRightPart(const QString &string, int index, int endIndex);
 
-    static SyntacticSymbol getNonterminalSymbol(QString &string);
-    static SyntacticSymbol getTerminalSymbol(QString &string);
+    /*!
+     * These methods used to read symbol which begins at index. Index is moved to next symbol, incorrect symbol
+     * is returned if there is no correct symbol at index.
+     *
+     * @param[in] string Text of rules file.
+     * @param[in,out] index Index of first character of symbol.
+     * @param[in] endIndex Index of end of rule part.
+     * @return Symbol.
+     */
+    static SyntacticSymbol getNonterminalSymbol(const QString &string, int &index, int endIndex);
+    static SyntacticSymbol getTerminalSymbol(const QString &string, int &index, int endIndex);
+    static QString getSymbolName(const QString &string, int index, int endIndex);
 
-    static void deleteComments(QString &oldString);
+    static bool isCommentBegin(const QString &string, int index);
+    static int findCommentEndIndex(const QString &string, int index);
 
-    static int findCommentBeginIndex(const QString &string, int startIndex);
-    static int findCommentEndIndex(const QString &string, int startIndex);
+    /*!
+     * This method used to skip character. Comments after character are skipped too.
+     *
+     * @param[in] string Text of rules file.
+     * @param[in] index Index of character.
+     * @param[in] endIndex Index of end of rule part.
+     * @return Index of next character or endIndex.
+     */
+    static int nextCharIndex(const QString &string, int index, int endIndex);
+    static int skipWhitespaces(const QString &string, int index, int endIndex);
 
 };
 
-void DeleteWhitespaceAtBegin(QString &string);
-void AppendListByCorrectItem(QList<SyntacticSymbol> &list, const SyntacticSymbol &item);
-int GetSyntacticSymbolNameLengthWithBrackets(const SyntacticSymbol &symbol);
-
 #endif // BACKUSNAURFORMPARSER_H
@@ -0,0 +1,64 @@
+#ifndef BUILTINDIALECT_H
+#define BUILTINDIALECT_H
+
+/*!
+ * @brief This struct used to store syntactic symbol of built-in dialect rules.
+ *
+ * Tables of built-in dialect are generated by DialectTableGenerator (see tools) from settings and rules files.
+ * Rules are already parsed, so FileReader only adds them to analyzers.
+ */
+struct BuiltInDialectSymbol
+{
+    int type;           //!< Type of symbol. (SyntacticSymbol::SyntacticSymbolType)
+    int category;       //!< Token category of symbol. (Token::TokenCategory)
+    const char *name;   //!< UTF-8 name of symbol.
+};
+
+/*!
+ * @brief This struct used to store production rule of built-in dialect.
+ *
+ * Left part of rule is symbol with index firstSymbol, right part is next symbolCount - 1 symbols.
+ */
+struct BuiltInDialectRule
+{
+    int firstSymbol;    //!< Index of left part in symbols table.
+    int symbolCount;    //!< Count of symbols in left and right parts.
+};
+
+/*!
+ * @brief This struct used to store state of compiled automaton of built-in dialect lexical analyzer.
+ *
+ * Settings are compiled by DialectTableGenerator, so FileReader sets compiled tables to lexical analyzer.
+ */
+struct BuiltInDialectState
+{
+    int category;       //!< Category of token which ends in this state. (Token::TokenCategory)
+    int flags;          //!< State flags. (LexicalTransitionTable::StateFlag)
+    int type;           //!< Type of token which ends in this state. (Expression::Type)
+    int error;          //!< Reason of incorrect token which stops in this state. (Token::LexicalError)
+    int terminalId;     //!< Terminal id of token which ends in this state.
+};
+
+/*!
+ * @brief This struct used to store slot of built-in dialect keywords perfect hash.
+ */
+struct BuiltInDialectKeyword
+{
+    const char *name;   //!< UTF-8 keyword of slot.
+    int seed;           //!< Seed of bucket with the same index.
+    int type;           //!< Type of keyword. (Expression::Type)
+    int terminalId;     //!< Terminal id of keyword.
+};
+
+/*!
+ * @brief This struct used to store conflict of built-in dialect rules which was found when parse table was built.
+ */
+struct BuiltInDialectConflict
+{
+    const char *nonterminal;    //!< UTF-8 nonterminal of conflict.
+    const char *terminal;       //!< UTF-8 terminal of conflict.
+    int firstRuleNumber;        //!< Number of rule which is used in table.
+    int secondRuleNumber;       //!< Number of conflicting rule.
+};
+
+#endif // BUILTINDIALECT_H
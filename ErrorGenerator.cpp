@@ -1,75 +1,189 @@
 #include "ErrorGenerator.h"
 #include "Token.h"
 #include "SyntacticSymbol.h"
+#include "NumberLiteral.h"
 
-QString ErrorGenerator::lexicalError(const Token &incorrectToken)
+Diagnostic ErrorGenerator::fileOpenError(const QString &fileName)
 {
-    return QString("(%1:%2)\t ").arg(incorrectToken.position().x()).arg(incorrectToken.position().y()) + incorrectToken.getErrorInformationWithLexeme();
+    return Diagnostic(Diagnostic::LEXICAL_STAGE, Diagnostic::FILE_OPEN_ERROR, QPoint(), QStringList() << fileName);
 }
 
-QString ErrorGenerator::syntacticError(const QList<Token> &tokenToParseList,const QList<SyntacticSymbol> &syntacticSymbolList)
+Diagnostic ErrorGenerator::lexicalError(const Token &incorrectToken)
+{
+    return Diagnostic(Diagnostic::LEXICAL_STAGE,
+                      Diagnostic::UNKNOWN_STRING_ERROR,
+                      incorrectToken.position(),
+                      QStringList() << incorrectToken.lexeme() << incorrectToken.errorInformation());
+}
+
+QString ErrorGenerator::lexicalErrorInformation(Token::LexicalError error,
+                                                int maxNumberLiteralLenght,
+                                                int maxStringLiteralLenght,
+                                                int maxIdentifierNameLenght,
+                                                const QString &beginStringLiteral)
+{
+    switch (error) {
+    case Token::WRONG_NUMBER_AFTER_DIGITS_ERROR:
+        return "Wrong number literal. After digits might be \".\" or \"E\".";
+    case Token::WRONG_NUMBER_AFTER_POINT_ERROR:
+        return "Wrong number literal. After \".\" must be digit!";
+    case Token::WRONG_NUMBER_ERROR:
+        return "Wrong number literal.";
+    case Token::WRONG_NUMBER_AFTER_EXPONENT_ERROR:
+        return "Wrong number literal. After \"E\" might be \"+\", \"-\" or digit.";
+    case Token::MISSING_EXPONENT_DIGITS_ERROR:
+        return "Wrong number literal. Digits are missing.";
+    case Token::NUMBER_TOO_LONG_ERROR:
+        return QString("Number literal lenght greater than %1 characters.").arg(maxNumberLiteralLenght);
+    case Token::WRONG_IDENTIFIER_ERROR:
+        return "Wrong identifier";
+    case Token::IDENTIFIER_TOO_LONG_ERROR:
+        return QString("Identifier lenght greater than %1 characters.").arg(maxIdentifierNameLenght);
+    case Token::MISSING_STRING_END_ERROR:
+        return "Character " + beginStringLiteral + " is missing";
+    case Token::STRING_TOO_LONG_ERROR:
+        return QString("String literal lenght greater than %1 characters.").arg(maxStringLiteralLenght);
+    default:
+        return "Unknown string";
+    }
+}
+
+Diagnostic ErrorGenerator::numberLiteralError(const Token &numberToken, const NumberLiteral &numberLiteral)
+{
+    return Diagnostic(Diagnostic::LEXICAL_STAGE,
+                      (numberLiteral.error() == NumberLiteral::OVERFLOW_ERROR) ? Diagnostic::NUMBER_OVERFLOW_ERROR
+                                                                               : Diagnostic::NUMBER_PRECISION_ERROR,
+                      numberToken.position(),
+                      QStringList() << numberToken.lexeme());
+}
+
+Diagnostic ErrorGenerator::syntacticError(const QList<Token> &tokenToParseList,const QList<SyntacticSymbol> &syntacticSymbolList)
 {
     if (tokenToParseList.isEmpty()) {
         if (syntacticSymbolList.isEmpty()) {
-            return QString();
+            return Diagnostic(Diagnostic::SYNTACTIC_STAGE, Diagnostic::EMPTY_SYNTACTIC_ERROR);
         } else {
-            return "\tCharacter is missing, can't parse " + MakeStringRepresentation(syntacticSymbolList.first());
+            return Diagnostic(Diagnostic::SYNTACTIC_STAGE,
+                              Diagnostic::MISSING_CHARACTER_ERROR,
+                              QPoint(),
+                              QStringList() << MakeStringRepresentation(syntacticSymbolList.first()));
         }
     } else {
-        QString tokenPosition = QString("(%1:%2)\t ")
-                                .arg(tokenToParseList.first().position().x())
-                                .arg(tokenToParseList.first().position().y());
-
+        const Token &token = tokenToParseList.first();
         if (syntacticSymbolList.isEmpty()) {
-            return tokenPosition + " Can't find rule to parse from " + MakeStringRepresentation(tokenToParseList.first());
+            return Diagnostic(Diagnostic::SYNTACTIC_STAGE,
+                              Diagnostic::NO_RULE_FOR_TOKEN_ERROR,
+                              token.position(),
+                              QStringList() << MakeStringRepresentation(token));
         } else {
-            if (tokenToParseList.first().category() == Token::LINE_FEED_CATEGORY) {
-                return tokenPosition + " Missing " + MakeStringRepresentation(syntacticSymbolList.first());
+            if (token.category() == Token::LINE_FEED_CATEGORY) {
+                return Diagnostic(Diagnostic::SYNTACTIC_STAGE,
+                                  Diagnostic::MISSING_SYMBOL_ERROR,
+                                  token.position(),
+                                  QStringList() << MakeStringRepresentation(syntacticSymbolList.first()));
             } else {
-                return tokenPosition
-                        + " Can't find rule to parse "
-                        + MakeStringRepresentation(syntacticSymbolList.first())
-                        + " from "
-                        + MakeStringRepresentation(tokenToParseList.first());
+                return Diagnostic(Diagnostic::SYNTACTIC_STAGE,
+                                  Diagnostic::NO_RULE_FOR_SYMBOL_ERROR,
+                                  token.position(),
+                                  QStringList() << MakeStringRepresentation(syntacticSymbolList.first())
+                                                << MakeStringRepresentation(token));
             }
         }
     }
-    return QString();
 }
 
-QString ErrorGenerator::undeclaratedIdentifierError(const Token &identifierToken)
+Diagnostic ErrorGenerator::undeclaratedIdentifierError(const Token &identifierToken)
 {
-    return QString("Undeclarated identifier " + identifierToken.lexeme() + " at (%1:%2)")
-            .arg(identifierToken.position().x())
-            .arg(identifierToken.position().y());
+    return Diagnostic(Diagnostic::SEMANTIC_STAGE,
+                      Diagnostic::UNDECLARED_IDENTIFIER_ERROR,
+                      identifierToken.position(),
+                      QStringList() << identifierToken.lexeme());
 }
 
-QString ErrorGenerator::redeclarationOfIdentifier(const Token &identifierToken)
+Diagnostic ErrorGenerator::redeclarationOfIdentifier(const Token &identifierToken)
 {
-    return QString("Redeclaration of identifier " + identifierToken.lexeme() + " at (%1:%2)")
-            .arg(identifierToken.position().x())
-            .arg(identifierToken.position().y());
+    return Diagnostic(Diagnostic::SEMANTIC_STAGE,
+                      Diagnostic::REDECLARED_IDENTIFIER_ERROR,
+                      identifierToken.position(),
+                      QStringList() << identifierToken.lexeme());
 }
 
-QString ErrorGenerator::incorrectTypeToAssignment(const Token &idToken)
+Diagnostic ErrorGenerator::incorrectDeclaration(const Token &declarationToken)
 {
-    return QString("Incorrect type to assignment at (%1,%2)\n")
-            .arg(idToken.position().x())
-            .arg(idToken.position().y());
+    return Diagnostic(Diagnostic::SEMANTIC_STAGE,
+                      Diagnostic::INCORRECT_DECLARATION_ERROR,
+                      declarationToken.position(),
+                      QStringList() << declarationToken.lexeme());
 }
 
-QString ErrorGenerator::incorrectIdentifier(const Token &idToken)
+Diagnostic ErrorGenerator::incorrectTypeToAssignment(const Token &idToken)
 {
-    return QString("Incorrect id at (%1,%2)\n")
-            .arg(idToken.position().x())
-            .arg(idToken.position().y());
+    return Diagnostic(Diagnostic::CODE_GENERATION_STAGE, Diagnostic::INCORRECT_ASSIGNMENT_TYPE_ERROR, idToken.position());
 }
 
-QString ErrorGenerator::cantDoOperation(const Token &operation, const Token &token1, const Token &token2)
+Diagnostic ErrorGenerator::incorrectIdentifier(const Token &idToken)
 {
-    return "Can't do operation "
-            + operation.lexeme()
-            + " with "
-            + token1.lexeme() + " "
-            + token2.lexeme() + "\n";
+    return Diagnostic(Diagnostic::CODE_GENERATION_STAGE, Diagnostic::INCORRECT_IDENTIFIER_ERROR, idToken.position());
+}
+
+Diagnostic ErrorGenerator::cantDoOperation(const Token &operation, const Token &token1, const Token &token2)
+{
+    return Diagnostic(Diagnostic::CODE_GENERATION_STAGE,
+                      Diagnostic::INCORRECT_OPERATION_ERROR,
+                      operation.position(),
+                      QStringList() << operation.lexeme() << token1.lexeme() << token2.lexeme());
+}
+
+Diagnostic ErrorGenerator::grammarConflictError(const SyntacticSymbol &nonterminal, const QString &terminal, int firstRuleNumber, int secondRuleNumber)
+{
+    return Diagnostic(Diagnostic::SYNTACTIC_STAGE,
+                      Diagnostic::GRAMMAR_CONFLICT_ERROR,
+                      QPoint(),
+                      QStringList() << MakeStringRepresentation(nonterminal) << terminal
+                                    << QString::number(firstRuleNumber) << QString::number(secondRuleNumber));
+}
+
+QString ErrorGenerator::message(const Diagnostic &diagnostic)
+{
+    const QStringList arguments = diagnostic.arguments();
+    const QString x = QString::number(diagnostic.position().x());
+    const QString y = QString::number(diagnostic.position().y());
+    const QString tokenPosition = "(" + x + ":" + y + ")\t ";
+
+    switch (diagnostic.code()) {
+    case Diagnostic::FILE_OPEN_ERROR:
+        return "Can't open file " + arguments.at(0);
+    case Diagnostic::UNKNOWN_STRING_ERROR:
+        return tokenPosition + arguments.at(0) + ": " + arguments.at(1);
+    case Diagnostic::NUMBER_OVERFLOW_ERROR:
+        return tokenPosition + arguments.at(0) + ": Number is too big";
+    case Diagnostic::NUMBER_PRECISION_ERROR:
+        return tokenPosition + arguments.at(0) + ": Number can't be stored without precision loss";
+    case Diagnostic::EMPTY_SYNTACTIC_ERROR:
+        return QString();
+    case Diagnostic::MISSING_CHARACTER_ERROR:
+        return "\tCharacter is missing, can't parse " + arguments.at(0);
+    case Diagnostic::NO_RULE_FOR_TOKEN_ERROR:
+        return tokenPosition + " Can't find rule to parse from " + arguments.at(0);
+    case Diagnostic::MISSING_SYMBOL_ERROR:
+        return tokenPosition + " Missing " + arguments.at(0);
+    case Diagnostic::NO_RULE_FOR_SYMBOL_ERROR:
+        return tokenPosition + " Can't find rule to parse " + arguments.at(0) + " from " + arguments.at(1);
+    case Diagnostic::UNDECLARED_IDENTIFIER_ERROR:
+        return "Undeclarated identifier " + arguments.at(0) + " at (" + x + ":" + y + ")";
+    case Diagnostic::REDECLARED_IDENTIFIER_ERROR:
+        return "Redeclaration of identifier " + arguments.at(0) + " at (" + x + ":" + y + ")";
+    case Diagnostic::INCORRECT_ASSIGNMENT_TYPE_ERROR:
+        return "Incorrect type to assignment at (" + x + "," + y + ")";
+    case Diagnostic::INCORRECT_IDENTIFIER_ERROR:
+        return "Incorrect id at (" + x + "," + y + ")";
+    case Diagnostic::INCORRECT_OPERATION_ERROR:
+        return "Can't do operation " + arguments.at(0) + " with " + arguments.at(1) + " " + arguments.at(2);
+    case Diagnostic::GRAMMAR_CONFLICT_ERROR:
+        return "Rules №" + arguments.at(2) + " and №" + arguments.at(3) + " both parse " + arguments.at(0) + " from " + arguments.at(1);
+    case Diagnostic::INCORRECT_DECLARATION_ERROR:
+        return "Incorrect declaration " + arguments.at(0) + " at (" + x + ":" + y + "), identifier and type are expected";
+    default:
+        return QString();
+    }
 }
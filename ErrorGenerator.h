@@ -12,8 +12,10 @@
 
 #include <QString>
 #include <QList>
+#include "Diagnostic.h"
+#include "Token.h"
 
-class Token;
+class NumberLiteral;
 class SyntacticSymbol;
 
 class ErrorGenerator
@@ -21,13 +23,58 @@ class ErrorGenerator
 
 public:
 
-    static QString lexicalError(const Token &incorrectToken);
-    static QString syntacticError(const QList<Token> &tokenToParseList,const QList<SyntacticSymbol> &syntacticSymbolList);
-    static QString undeclaratedIdentifierError(const Token &incorrectToken);
-    static QString redeclarationOfIdentifier(const Token &identifierToken);
-    static QString incorrectTypeToAssignment(const Token &idToken);
-    static QString incorrectIdentifier(const Token &idToken);
-    static QString cantDoOperation(const Token &operation, const Token &token1, const Token &token2);
+    static Diagnostic fileOpenError(const QString &fileName);
+    static Diagnostic lexicalError(const Token &incorrectToken);
+
+    /*!
+     * This method used to make reason of incorrect token.
+     *
+     * @param[in] error Reason which was found by lexical analyzer.
+     * @param[in] maxNumberLiteralLenght Maximum number literal lenght.
+     * @param[in] maxStringLiteralLenght Maximum string literal lenght.
+     * @param[in] maxIdentifierNameLenght Maximum identifier name lenght.
+     * @param[in] beginStringLiteral Begin of string literal.
+     * @return Error information.
+     */
+    static QString lexicalErrorInformation(Token::LexicalError error,
+                                           int maxNumberLiteralLenght,
+                                           int maxStringLiteralLenght,
+                                           int maxIdentifierNameLenght,
+                                           const QString &beginStringLiteral);
+    static Diagnostic numberLiteralError(const Token &numberToken, const NumberLiteral &numberLiteral);
+    static Diagnostic syntacticError(const QList<Token> &tokenToParseList,const QList<SyntacticSymbol> &syntacticSymbolList);
+    static Diagnostic undeclaratedIdentifierError(const Token &incorrectToken);
+    static Diagnostic redeclarationOfIdentifier(const Token &identifierToken);
+
+    /*!
+     * This method used to make error of declaration without identifier or type.
+     *
+     * @param[in] declarationToken Keyword which begins declaration.
+     * @return Error information.
+     */
+    static Diagnostic incorrectDeclaration(const Token &declarationToken);
+    static Diagnostic incorrectTypeToAssignment(const Token &idToken);
+    static Diagnostic incorrectIdentifier(const Token &idToken);
+    static Diagnostic cantDoOperation(const Token &operation, const Token &token1, const Token &token2);
+
+    /*!
+     * This method used to make error of rules which are not LL(1).
+     *
+     * @param[in] nonterminal Left part of rules.
+     * @param[in] terminal Terminal which both rules parse from.
+     * @param[in] firstRuleNumber Number of rule which is used.
+     * @param[in] secondRuleNumber Number of conflicting rule.
+     * @return Error information.
+     */
+    static Diagnostic grammarConflictError(const SyntacticSymbol &nonterminal, const QString &terminal, int firstRuleNumber, int secondRuleNumber);
+
+    /*!
+     * This method used to make error message.
+     *
+     * @param[in] diagnostic Error information.
+     * @return Error message.
+     */
+    static QString message(const Diagnostic &diagnostic);
 
 };
 
@@ -10,12 +10,106 @@
 #include "SyntacticAnalyzer.h"
 #include "Translator.h"
 
+#ifdef BUILT_IN_DIALECT
+#include "BuiltInDialectTables.h"
+#ifdef GENERATED_PARSER
+#include "GeneratedParser.h"
+#endif
+
+static SyntacticSymbol MakeBuiltInSymbol(const BuiltInDialectSymbol &symbol)
+{
+    if (symbol.name == NULL)
+        return SyntacticSymbol();
+    return SyntacticSymbol(QString::fromUtf8(symbol.name),
+                           static_cast<SyntacticSymbol::SyntacticSymbolType>(symbol.type),
+                           static_cast<Token::TokenCategory>(symbol.category));
+}
+
+template <typename T, typename Element>
+static QVector<T> MakeBuiltInVector(const Element *array, int size)
+{
+    QVector<T> vector(size);
+    for (int i = 0; i < size; i++)
+        vector[i] = static_cast<T>(array[i]);
+    return vector;
+}
+
+/*!
+ * This function used to set compiled automaton and keywords perfect hash of built-in dialect. Terminal id
+ * table of lexical analyzer must be set from rules of built-in dialect before.
+ *
+ * @param[in] lexicalAnalyzer Lexical analyzer.
+ */
+static void SetBuiltInTransitionTable(LexicalAnalyzer *lexicalAnalyzer)
+{
+    // Table has dead and start states after creation
+    LexicalTransitionTable transitionTable;
+    QVector<int> stateTerminalIds;
+    for (int state = 0; state < BUILT_IN_STATE_COUNT; state++) {
+        const BuiltInDialectState &builtInState = BUILT_IN_STATES[state];
+        if (state >= transitionTable.stateCount())
+            transitionTable.addState();
+        transitionTable.setStateToken(state,
+                                      static_cast<Token::TokenCategory>(builtInState.category),
+                                      builtInState.flags,
+                                      static_cast<Expression::Type>(builtInState.type));
+        transitionTable.setStateError(state, static_cast<Token::LexicalError>(builtInState.error));
+        stateTerminalIds << builtInState.terminalId;
+    }
+    transitionTable.setCompiledTable(MakeBuiltInVector<int>(BUILT_IN_CHARACTER_CLASSES, LexicalTransitionTable::COLUMN_COUNT),
+                                     MakeBuiltInVector<quint16>(BUILT_IN_TRANSITIONS, BUILT_IN_STATE_COUNT * BUILT_IN_CHARACTER_CLASS_COUNT),
+                                     MakeBuiltInVector<bool>(BUILT_IN_TOKEN_END_CLASSES, BUILT_IN_CHARACTER_CLASS_COUNT));
+
+    QVector<QString> keywords;
+    QVector<int> seeds;
+    QVector<Expression::Type> keywordTypes;
+    QVector<int> keywordTerminalIds;
+    for (int i = 0; i < BUILT_IN_KEYWORD_COUNT; i++) {
+        const BuiltInDialectKeyword &keyword = BUILT_IN_KEYWORD_SLOTS[i];
+        keywords << QString::fromUtf8(keyword.name);
+        seeds << keyword.seed;
+        keywordTypes << static_cast<Expression::Type>(keyword.type);
+        keywordTerminalIds << keyword.terminalId;
+    }
+    PerfectHash keywordPerfectHash;
+    keywordPerfectHash.setTable(keywords, seeds);
+    lexicalAnalyzer->setCompiledTransitionTable(transitionTable, keywordPerfectHash, keywordTypes, keywordTerminalIds, stateTerminalIds);
+}
+
+/*!
+ * This function used to set parse table of built-in dialect. Rules of built-in dialect must be added before.
+ *
+ * @param[in] syntacticAnalyzer Syntactic analyzer.
+ * @return If table matches rules returns true other returns false.
+ */
+static bool SetBuiltInParseTable(SyntacticAnalyzer *syntacticAnalyzer)
+{
+    const int cellCount = BUILT_IN_NONTERMINAL_COUNT * (BUILT_IN_TERMINAL_COUNT + 1);
+    DiagnosticList grammarDiagnostics;
+    for (int i = 0; BUILT_IN_GRAMMAR_CONFLICTS[i].nonterminal != NULL; i++) {
+        const BuiltInDialectConflict &conflict = BUILT_IN_GRAMMAR_CONFLICTS[i];
+        grammarDiagnostics.append(Diagnostic(Diagnostic::SYNTACTIC_STAGE,
+                                             Diagnostic::GRAMMAR_CONFLICT_ERROR,
+                                             QPoint(),
+                                             QStringList() << QString::fromUtf8(conflict.nonterminal)
+                                                           << QString::fromUtf8(conflict.terminal)
+                                                           << QString::number(conflict.firstRuleNumber)
+                                                           << QString::number(conflict.secondRuleNumber)));
+    }
+    return syntacticAnalyzer->setParseTable(MakeBuiltInVector<int>(BUILT_IN_PARSE_TABLE, cellCount),
+                                            MakeBuiltInVector<int>(BUILT_IN_NULLABLE_RULES, BUILT_IN_NONTERMINAL_COUNT),
+                                            MakeBuiltInVector<bool>(BUILT_IN_FIRST_SETS, cellCount),
+                                            MakeBuiltInVector<bool>(BUILT_IN_FOLLOW_SETS, cellCount),
+                                            grammarDiagnostics);
+}
+#endif
+
 QString FileReader::getTextFromFile(const QString &fileName)
 {
     if (fileName.isEmpty())
         return QString();
     QFile file (fileName);
-    if (!file.open(QIODevice::ReadWrite | QIODevice::Text))
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
         return QString();
 
     QTextStream inputTextStream(&file);
@@ -47,10 +141,52 @@ void FileReader::loadSyntacticAnalyzerRules(const QString &fileName, Translator
     QString sourceText = getTextFromFile(fileName);
     QList <BackusNaurFormRule> rulesList;
     rulesList = BackusNaurFormParser::parse(sourceText);
+    addSyntacticAnalyzerRules(rulesList, translator);
+}
+
+bool FileReader::loadBuiltInDialect(Translator *translator)
+{
+#ifdef BUILT_IN_DIALECT
+    LexicalAnalyzer *lexicalAnalyzer = translator->lexicalAnalyzer();
+    lexicalAnalyzer->setMaxNumberLiteralLenght(BUILT_IN_MAX_NUMBER_LITERAL_LENGHT);
+    lexicalAnalyzer->setMaxIdentifierNameLenght(BUILT_IN_MAX_IDENTIFIER_NAME_LENGHT);
+    lexicalAnalyzer->setMaxStringLiteralLenght(BUILT_IN_MAX_STRING_LITERAL_LENGHT);
+    lexicalAnalyzer->setIdentifierRegExp(QRegExp(QString::fromUtf8(BUILT_IN_IDENTIFIER_REG_EXP)));
+    lexicalAnalyzer->setSpaceRegExp(QRegExp(QString::fromUtf8(BUILT_IN_SPACE_REG_EXP)));
+    lexicalAnalyzer->setBeginStringLiteral(QString::fromUtf8(BUILT_IN_BEGIN_STRING_LITERAL));
+    for (int i = 0; BUILT_IN_KEYWORDS[i] != NULL; i++)
+        lexicalAnalyzer->addKeyword(QString::fromUtf8(BUILT_IN_KEYWORDS[i]));
+    for (int i = 0; BUILT_IN_CHARACTER_TOKENS[i] != NULL; i++)
+        lexicalAnalyzer->addCharacterToken(QString::fromUtf8(BUILT_IN_CHARACTER_TOKENS[i]));
+
+    // Settings above are compiled only if they are changed later, tables are set after terminal ids of rules
     SyntacticAnalyzer *syntacticAnalyzer = translator->syntacticAnalyzer();
-    foreach (BackusNaurFormRule rule, rulesList) {
-        syntacticAnalyzer->addProductRule(rule.leftPart(), rule.rightPart());
+    for (int i = 0; i < BUILT_IN_RULE_COUNT; i++) {
+        const BuiltInDialectRule &rule = BUILT_IN_RULES[i];
+        QList<SyntacticSymbol> rightPart;
+        for (int j = 1; j < rule.symbolCount; j++)
+            rightPart << MakeBuiltInSymbol(BUILT_IN_SYMBOLS[rule.firstSymbol + j]);
+        syntacticAnalyzer->addProductRule(MakeBuiltInSymbol(BUILT_IN_SYMBOLS[rule.firstSymbol]), rightPart);
     }
+    bool isParseTableSet = SetBuiltInParseTable(syntacticAnalyzer);
+    if (!isParseTableSet)
+        syntacticAnalyzer->buildParseTable();
+    lexicalAnalyzer->setTerminalIdTable(syntacticAnalyzer->terminalIdTable());
+    if (isParseTableSet)
+        SetBuiltInTransitionTable(lexicalAnalyzer);
+    else
+        lexicalAnalyzer->compileTransitionTable();
+#ifdef GENERATED_PARSER
+    // Parser is generated from the same rules, counts only protect from mismatched build
+    translator->syntacticAnalyzer()->setGeneratedParser(ParseGeneratedDialect,
+                                                        GENERATED_PARSER_RULE_COUNT,
+                                                        GENERATED_PARSER_TERMINAL_COUNT);
+#endif
+    return true;
+#else
+    Q_UNUSED(translator);
+    return false;
+#endif
 }
 
 bool FileReader::isFileExist(const QString &fileName)
@@ -80,6 +216,18 @@ void FileReader::loadLexicalAnalyzerSettings(const QJsonObject &jsonObject, Tran
     foreach (const QJsonValue& value, characterTokenArray) {
         lexicalAnalyzer->addCharacterToken(value.toString());
     }
+
+    lexicalAnalyzer->compileTransitionTable();
+}
+
+void FileReader::addSyntacticAnalyzerRules(const QList<BackusNaurFormRule> &rulesList, Translator *translator)
+{
+    SyntacticAnalyzer *syntacticAnalyzer = translator->syntacticAnalyzer();
+    foreach (BackusNaurFormRule rule, rulesList) {
+        syntacticAnalyzer->addProductRule(rule.leftPart(), rule.rightPart());
+    }
+    syntacticAnalyzer->buildParseTable();
+    translator->lexicalAnalyzer()->setTerminalIdTable(syntacticAnalyzer->terminalIdTable());
 }
 
 QJsonDocument FileReader::loadJson(const QString &fileName)
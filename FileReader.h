@@ -11,11 +11,13 @@
 #define FILEREADER_H
 
 #include <QString>
+#include <QList>
 #include <QJsonDocument>
 
 class LexicalAnalyzer;
 class SyntacticAnalyzer;
 class Translator;
+class BackusNaurFormRule;
 
 class FileReader
 {
@@ -30,6 +32,16 @@ public:
 
     static void loadSyntacticAnalyzerRules(const QString &fileName, Translator *translator);
 
+    /*!
+     * This method used to load settings and rules of built-in dialect. Tables of dialect are generated when
+     * application is built with CONFIG+=built_in_dialect, so no files are read and parsed. Compiled automaton
+     * and parse table are generated too, so settings are not compiled and parse table is not built.
+     *
+     * @param[in] translator Translator.
+     * @return If application has built-in dialect returns true other returns false.
+     */
+    static bool loadBuiltInDialect(Translator *translator);
+
     static bool isFileExist(const QString &fileName);
 
 private:
@@ -38,6 +50,14 @@ private:
 
     static void loadLexicalAnalyzerSettings(const QJsonObject &lexicalAnalyzerJsonObject, Translator *translator);
 
+    /*!
+     * This method used to add parsed rules to syntactic analyzer and build its parse table.
+     *
+     * @param[in] rulesList Rules.
+     * @param[in] translator Translator.
+     */
+    static void addSyntacticAnalyzerRules(const QList<BackusNaurFormRule> &rulesList, Translator *translator);
+
 };
 
 
@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT       += core gui
+QT       += core gui concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -17,15 +17,29 @@ INCLUDEPATH += translator
 SOURCES += main.cpp\
         gui/mainwindow.cpp\
         gui/SourceCodeInputTextEdit.cpp \
+        gui/SourceCodeHighlighter.cpp \
         gui/CompileOutputTextEdit.cpp \
         gui/HTMLColors.cpp \
         gui/HTMLMarkupGenerator.cpp \
         gui/ProgramBlockTreeWidget.cpp \
+        gui/UsedRulesListModel.cpp \
         translator/LexicalAnalyzer.cpp \
+        translator/LexicalTransitionTable.cpp \
+        translator/TokenCursor.cpp \
+        translator/TokenStream.cpp \
+        translator/PerfectHash.cpp \
+        translator/StringPool.cpp \
+        translator/Diagnostic.cpp \
+        translator/NumberLiteral.cpp \
+        translator/Utf8SourceCode.cpp \
+        translator/CharacterRunScanner.cpp \
+        translator/TerminalIdTable.cpp \
         translator/Identifier.cpp \
         translator/Token.cpp \
         translator/SyntacticAnalyzer.cpp \
         translator/SyntacticSymbol.cpp \
+        translator/SyntaxTree.cpp \
+        translator/GeneratedParserContext.cpp \
         translator/Production.cpp \
         translator/Block.cpp \
         translator/SemanticAnalyzer.cpp \
@@ -39,15 +53,31 @@ SOURCES += main.cpp\
 
 HEADERS += gui/mainwindow.h\
         gui/SourceCodeInputTextEdit.h \
+        gui/SourceCodeHighlighter.h \
         gui/CompileOutputTextEdit.h \
         gui/HTMLColors.h \
         gui/HTMLMarkupGenerator.h \
         gui/ProgramBlockTreeWidget.h \
+        gui/UsedRulesListModel.h \
         translator/LexicalAnalyzer.h \
+        translator/LexicalTransitionTable.h \
+        translator/TokenCursor.h \
+        translator/TokenStream.h \
+        translator/PerfectHash.h \
+        translator/StringPool.h \
+        translator/Diagnostic.h \
+        translator/NumberLiteral.h \
+        translator/Utf8SourceCode.h \
+        translator/SourceText.h \
+        translator/CharacterRunScanner.h \
+        translator/TerminalIdTable.h \
         translator/Identifier.h \
         translator/Token.h \
         translator/SyntacticAnalyzer.h \
         translator/SyntacticSymbol.h \
+        translator/SyntaxTree.h \
+        translator/ParseEventHandler.h \
+        translator/GeneratedParserContext.h \
         translator/Production.h \
         translator/Block.h \
         translator/SemanticAnalyzer.h \
@@ -55,6 +85,7 @@ HEADERS += gui/mainwindow.h\
         translator/Expression.h \
         translator/Translator.h \
         FileReader.h \
+        BuiltInDialect.h \
         BackusNaurFormParser.h \
         BackusNaurFormRule.h \
         ErrorGenerator.h
@@ -63,4 +94,55 @@ FORMS  += gui/mainwindow.ui
 
 CONFIG += mobility
 
+# Tables of built-in dialect and generated parser are constexpr arrays
+CONFIG += c++11
 
+# Built-in dialect: qmake CONFIG+=built_in_dialect [DIALECT_SETTINGS=<file.json>] [DIALECT_RULES=<file.rules>]
+# DialectTableGenerator is built first and turns settings and rules into tables of BuiltInDialectTables.h.
+# Dialect files are not part of repository, so default files must be put next to Translator.pro.
+built_in_dialect {
+    isEmpty(DIALECT_SETTINGS): DIALECT_SETTINGS = $$PWD/LexicalAnalyzersSettings.json
+    isEmpty(DIALECT_RULES): DIALECT_RULES = $$PWD/SyntacticAnalyzersSetting.rules
+    !exists($$DIALECT_SETTINGS): error("Settings of built-in dialect $$DIALECT_SETTINGS are not found, set DIALECT_SETTINGS=<file.json>")
+    !exists($$DIALECT_RULES): error("Rules of built-in dialect $$DIALECT_RULES are not found, set DIALECT_RULES=<file.rules>")
+
+    DIALECT_GENERATOR_DIR = $$OUT_PWD/tools/DialectTableGenerator
+    DIALECT_GENERATOR = $$DIALECT_GENERATOR_DIR/DialectTableGenerator
+    win32: DIALECT_GENERATOR = $${DIALECT_GENERATOR}.exe
+    mkpath($$DIALECT_GENERATOR_DIR)
+
+    dialectGenerator.target = $$DIALECT_GENERATOR
+    dialectGenerator.commands = cd $$shell_path($$DIALECT_GENERATOR_DIR) && $(QMAKE) $$shell_path($$PWD/tools/DialectTableGenerator/DialectTableGenerator.pro) && $(MAKE)
+
+    dialectTables.target = BuiltInDialectTables.h
+    dialectTables.commands = $$shell_path($$DIALECT_GENERATOR) $$shell_path($$DIALECT_SETTINGS) $$shell_path($$DIALECT_RULES) BuiltInDialectTables.h
+    dialectTables.depends = $$DIALECT_GENERATOR $$DIALECT_SETTINGS $$DIALECT_RULES
+
+    QMAKE_EXTRA_TARGETS += dialectGenerator dialectTables
+    PRE_TARGETDEPS += BuiltInDialectTables.h
+    QMAKE_CLEAN += BuiltInDialectTables.h
+    INCLUDEPATH += $$OUT_PWD
+    DEFINES += BUILT_IN_DIALECT
+}
+
+# Generated parser: qmake CONFIG+="built_in_dialect generated_parser"
+# ParserGenerator turns rules of built-in dialect into recursive-descent parser of GeneratedParser.h.
+# Syntactic analyzer uses it for correct programs and falls back to analysis by table on errors.
+built_in_dialect:generated_parser {
+    PARSER_GENERATOR_DIR = $$OUT_PWD/tools/ParserGenerator
+    PARSER_GENERATOR = $$PARSER_GENERATOR_DIR/ParserGenerator
+    win32: PARSER_GENERATOR = $${PARSER_GENERATOR}.exe
+    mkpath($$PARSER_GENERATOR_DIR)
+
+    parserGenerator.target = $$PARSER_GENERATOR
+    parserGenerator.commands = cd $$shell_path($$PARSER_GENERATOR_DIR) && $(QMAKE) $$shell_path($$PWD/tools/ParserGenerator/ParserGenerator.pro) && $(MAKE)
+
+    generatedParser.target = GeneratedParser.h
+    generatedParser.commands = $$shell_path($$PARSER_GENERATOR) $$shell_path($$DIALECT_RULES) GeneratedParser.h
+    generatedParser.depends = $$PARSER_GENERATOR $$DIALECT_RULES
+
+    QMAKE_EXTRA_TARGETS += parserGenerator generatedParser
+    PRE_TARGETDEPS += GeneratedParser.h
+    QMAKE_CLEAN += GeneratedParser.h
+    DEFINES += GENERATED_PARSER
+}
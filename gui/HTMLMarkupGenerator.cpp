@@ -17,30 +17,35 @@ QString HTMLMarkupGenerator::getMessageForLog(Translator *translator)
     if (translator->lexicalAnalyzerComplete()) {
         messageForLog += this->getSuccessfulResultMessage("Lexical analyzer");
     } else {
-        messageForLog += this->getFailedResultMessage("Lexical analyzer", translator->lexicalAnalyzer()->errorText());
+        messageForLog += this->getFailedResultMessage("Lexical analyzer", translator->lexicalAnalyzer()->diagnostics());
     }
 
     if (translator->syntacticAnalyzerComplete()) {
         messageForLog += this->getSuccessfulResultMessage("Syntactic analyzer");
     } else {
-        messageForLog += this->getFailedResultMessage("Syntactic analyzer", translator->syntacticAnalyzer()->errorText());
+        messageForLog += this->getFailedResultMessage("Syntactic analyzer", translator->syntacticAnalyzer()->diagnostics());
     }
 
     if (translator->semanticAnalyzerComplete()) {
         messageForLog += this->getSuccessfulResultMessage("Semantic analyzer");
     } else {
-        messageForLog += this->getFailedResultMessage("Semantic analyzer", translator->semanticAnalyzer()->errorText());
+        messageForLog += this->getFailedResultMessage("Semantic analyzer", translator->semanticAnalyzer()->diagnostics());
     }
 
     if (translator->threeAddressCodeGeneratorComplete()) {
         messageForLog += this->getSuccessfulResultMessage("Code generator");
     } else {
-        messageForLog += this->getFailedResultMessage("Code generator", translator->threeAddressCodeGenerator()->errorText());
+        messageForLog += this->getFailedResultMessage("Code generator", translator->threeAddressCodeGenerator()->diagnostics());
     }
 
     return messageForLog;
 }
 
+QString HTMLMarkupGenerator::getGrammarMessageForLog(SyntacticAnalyzer *analyzer)
+{
+    return this->getFailedResultMessage("Syntactic analyzer rules", analyzer->grammarDiagnostics());
+}
+
 QString HTMLMarkupGenerator::getSuccessfulResultMessage(const QString &analyzerName) const
 {
     return QString("<font color=" + HTMLColors::darkBlue + ">"
@@ -49,14 +54,14 @@ QString HTMLMarkupGenerator::getSuccessfulResultMessage(const QString &analyzerN
                    + QTime::currentTime().toString() + "\n</font>");
 }
 
-QString HTMLMarkupGenerator::getFailedResultMessage(const QString &analyzerName, QString errors) const
+QString HTMLMarkupGenerator::getFailedResultMessage(const QString &analyzerName, const DiagnosticList &diagnostics) const
 {
+    QString errors = diagnostics.text();
     errors.replace("<","&lt;").replace(">","&gt;");
-    int errorCount = errors.split(QRegExp("\n")).count() - 1;
     return QString("<font color=" + HTMLColors::red + ">"
                    + analyzerName + ":\n"
                    + errors
-                   + QString("Detected %1 errors    ").arg(errorCount)
+                   + QString("Detected %1 errors    ").arg(diagnostics.size())
                    + QTime::currentTime().toString() + "\n</font>");
 }
 
@@ -102,8 +107,14 @@ QString HTMLMarkupGenerator::getSourceCodeHTMLMarkup(LexicalAnalyzer* analyzer)
 {
     QString plainTextWithMarkedUpTokens;
 
-    foreach (Token currentToken, analyzer->tokenList()) {
-        plainTextWithMarkedUpTokens += this->getTokenHTMLRepresentation(currentToken);
+    // Spaces are taken from trivia table before every token
+    TokenStream tokenStream = analyzer->tokenStream();
+    int triviaIndex = 0;
+    for (int i = 0; i <= tokenStream.size(); i++) {
+        while ((triviaIndex < tokenStream.triviaCount()) && (tokenStream.triviaTokenIndex(triviaIndex) == i))
+            plainTextWithMarkedUpTokens += this->getTokenHTMLRepresentation(tokenStream.triviaToken(triviaIndex++));
+        if (i < tokenStream.size())
+            plainTextWithMarkedUpTokens += this->getTokenHTMLRepresentation(tokenStream.token(i));
     }
     return PlainTextToHTML(plainTextWithMarkedUpTokens);
 }
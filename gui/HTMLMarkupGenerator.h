@@ -18,6 +18,7 @@ class SemanticAnalyzer;
 class ThreeAddressCodeGenerator;
 class Token;
 class Translator;
+class DiagnosticList;
 
 
 /*!
@@ -30,6 +31,14 @@ public:
 
     QString getMessageForLog(Translator *translator);
 
+    /*!
+     * This method returns string with conflicts of production rules.
+     *
+     * @param[in] analyzer Syntactic analyzer with built parse table.
+     * @return String with failed result and conflicts list.
+     */
+    QString getGrammarMessageForLog(SyntacticAnalyzer *analyzer);
+
     /*!
      * This method returns marked up source code.
      *
@@ -38,6 +47,14 @@ public:
      */
     QString getSourceCodeHTMLMarkup(LexicalAnalyzer *analyzer) const;
 
+    /*!
+     * This method returns string with color code of token.
+     *
+     * @param[in] token Token.
+     * @return String with color code. Spaces and line feeds have no color.
+     */
+    QString getTokenColorName(const Token &token) const;
+
 private:
 
     /*!
@@ -52,19 +69,10 @@ private:
      * This method returns string with failed result and errors list.
      *
      * @param[in] analyzerName Ananyzer name.
-     * @param[in] errors Errors string.
+     * @param[in] diagnostics Errors list.
      * @return String with failed result and errors list.
      */
-    QString getFailedResultMessage(const QString &analyzerName, QString errors) const;
-
-
-    /*!
-     * This method returns string with color code of token.
-     *
-     * @param[in] token Token.
-     * @return String with color code.
-     */
-    QString getTokenColorName(const Token &token) const;
+    QString getFailedResultMessage(const QString &analyzerName, const DiagnosticList &diagnostics) const;
 
     /*!
      * This method returns string with marked up tokens lexeme. Use to markup source code.
@@ -0,0 +1,30 @@
+#include "SourceCodeHighlighter.h"
+#include "LexicalAnalyzer.h"
+#include <QTextCharFormat>
+
+SourceCodeHighlighter::SourceCodeHighlighter(QTextDocument *document, LexicalAnalyzer *lexicalAnalyzer) :
+    QSyntaxHighlighter(document),
+    m_lexicalAnalyzer(lexicalAnalyzer)
+{}
+
+void SourceCodeHighlighter::highlightBlock(const QString &text)
+{
+    if (!m_lexicalAnalyzer->isTransitionTableCompiled())
+        m_lexicalAnalyzer->compileTransitionTable();
+
+    const int lineNumber = this->currentBlock().blockNumber();
+    int index = 0;
+    while (index < text.length()) {
+        const int tokenBeginIndex = index;
+        Token token = m_lexicalAnalyzer->getNextToken(text, index, QPoint(tokenBeginIndex, lineNumber));
+
+        // Spaces are not marked up, incorrect lexemes are underlined
+        QTextCharFormat format;
+        QString colorName = m_markupGenerator.getTokenColorName(token);
+        if (!token.isCorrect())
+            format.setFontUnderline(true);
+        else if (!colorName.isEmpty())
+            format.setForeground(QColor(colorName));
+        this->setFormat(tokenBeginIndex, index - tokenBeginIndex, format);
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef SOURCECODEHIGHLIGHTER_H
+#define SOURCECODEHIGHLIGHTER_H
+
+#include <QSyntaxHighlighter>
+#include "HTMLMarkupGenerator.h"
+
+class LexicalAnalyzer;
+
+/*!
+ * @brief This class used to mark up source code in text edit.
+ *
+ * Document calls highlighter only for lines which were changed, so marking up costs time proportional
+ * to change. No token contains line feed, so every line is analyzed separately. Tokens get colors of
+ * HTML markup and incorrect tokens are underlined.
+ */
+class SourceCodeHighlighter : public QSyntaxHighlighter
+{
+
+public:
+
+    /*!
+     * This constructor used to create highlighter of document.
+     *
+     * @param[in] document Document with source code.
+     * @param[in] lexicalAnalyzer Lexical analyzer with loaded settings. It must live longer than highlighter.
+     */
+    SourceCodeHighlighter(QTextDocument *document, LexicalAnalyzer *lexicalAnalyzer);
+
+protected:
+
+    void highlightBlock(const QString &text);
+
+private:
+
+    LexicalAnalyzer *m_lexicalAnalyzer;         //!< Lexical analyzer which finds tokens of line.
+    HTMLMarkupGenerator m_markupGenerator;      //!< Markup generator which gives colors of tokens.
+
+};
+
+#endif // SOURCECODEHIGHLIGHTER_H
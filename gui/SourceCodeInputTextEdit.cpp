@@ -1,13 +1,18 @@
 #include "SourceCodeInputTextEdit.h"
-#include "HTMLMarkupGenerator.h"
 #include <QScrollBar>
 #include <QTimer>
 
 SourceCodeInputTextEdit::SourceCodeInputTextEdit(QWidget *parent) :
     QTextEdit(parent),
-    m_textUpdateTimer(new QTimer)
+    m_textUpdateTimer(new QTimer),
+    m_isTextUpdating(false),
+    m_isTextChanged(false),
+    m_changeBegin(0),
+    m_changeEnd(0),
+    m_changeLengthDelta(0)
 {
     connect(this, SIGNAL(textChanged()), SLOT(onTextChangedSlot()));
+    connect(this->document(), SIGNAL(contentsChange(int, int, int)), SLOT(onContentsChangeSlot(int, int, int)));
     connect(this, SIGNAL(cursorPositionChanged()), SLOT(onCursorPositionChangedSlot()));
     connect(m_textUpdateTimer, SIGNAL(timeout()), SLOT(onTextUpdateTimerTimeoutSlot()));
 
@@ -43,16 +48,49 @@ void SourceCodeInputTextEdit::onCursorPositionChangedSlot()
 
 void SourceCodeInputTextEdit::onTextChangedSlot()
 {
-    if (!m_textUpdateTimer->isActive())
+    // Text changed by update doesn't start next update
+    if (!m_isTextUpdating && !m_textUpdateTimer->isActive())
         m_textUpdateTimer->start(100);
 }
 
+void SourceCodeInputTextEdit::onContentsChangeSlot(int position, int charsRemoved, int charsAdded)
+{
+    if (m_isTextUpdating)
+        return;
+
+    if (!m_isTextChanged) {
+        m_isTextChanged = true;
+        m_changeBegin = position;
+        m_changeEnd = position + charsAdded;
+        m_changeLengthDelta = charsAdded - charsRemoved;
+        return;
+    }
+
+    // Ranges are united in current text coordinates
+    m_changeBegin = qMin(m_changeBegin, position);
+    m_changeEnd = qMax(m_changeEnd, position + charsRemoved) + charsAdded - charsRemoved;
+    m_changeLengthDelta += charsAdded - charsRemoved;
+}
+
 void SourceCodeInputTextEdit::onTextUpdateTimerTimeoutSlot()
 {
+    m_textUpdateTimer->stop();
+    if (!m_isTextChanged)
+        return;
+
     int cursorPosBackup = textCursor().position();
     int scrollPosBackup = verticalScrollBar()->value();
 
-    emit updateTextByTimerSignal();
+    // Change of whole document can include last paragraph separator which is not in plain text
+    int textLength = this->document()->characterCount() - 1;
+    m_changeEnd = qBound(m_changeBegin, m_changeEnd, qMax(m_changeBegin, textLength));
+    int charsAdded = m_changeEnd - m_changeBegin;
+    int charsRemoved = charsAdded - m_changeLengthDelta;
+    m_isTextChanged = false;
+
+    m_isTextUpdating = true;
+    emit updateTextByTimerSignal(m_changeBegin, charsRemoved, charsAdded);
+    m_isTextUpdating = false;
 
     QTextCursor cursor = textCursor();
     cursor.setPosition(cursorPosBackup, QTextCursor::MoveAnchor);
@@ -60,7 +98,5 @@ void SourceCodeInputTextEdit::onTextUpdateTimerTimeoutSlot()
 
     QScrollBar *scrollBar = verticalScrollBar();
     scrollBar->setValue(scrollPosBackup);
-
-    m_textUpdateTimer->stop();
 }
 
@@ -43,14 +43,27 @@ signals:
 
     /*!
      * This signal emits update current widget.
+     *
+     * @param[in] position Index of first character changed after last update.
+     * @param[in] charsRemoved Count of removed characters.
+     * @param[in] charsAdded Count of added characters.
      */
-    void updateTextByTimerSignal();
+    void updateTextByTimerSignal(int position, int charsRemoved, int charsAdded);
 
 public slots:
 
 
     void onTextChangedSlot();
 
+    /*!
+     * This slot used to collect changed characters range between updates.
+     *
+     * @param[in] position Index of first changed character.
+     * @param[in] charsRemoved Count of removed characters.
+     * @param[in] charsAdded Count of added characters.
+     */
+    void onContentsChangeSlot(int position, int charsRemoved, int charsAdded);
+
     void onCursorPositionChangedSlot();
 
     /*!
@@ -60,7 +73,13 @@ public slots:
 
 private:
 
-    QTimer *m_textUpdateTimer; //!< Timer for updating widget.
+    QTimer *m_textUpdateTimer;  //!< Timer for updating widget.
+
+    bool m_isTextUpdating;      //!< Is text changed by update.
+    bool m_isTextChanged;       //!< Is text changed after last update.
+    int m_changeBegin;          //!< Index of first changed character after last update.
+    int m_changeEnd;            //!< Index after last changed character in current text.
+    int m_changeLengthDelta;    //!< Difference between current text length and text length after last update.
 
 };
 
@@ -0,0 +1,29 @@
+#include "UsedRulesListModel.h"
+#include "SyntacticAnalyzer.h"
+
+UsedRulesListModel::UsedRulesListModel(QObject *parent) :
+    QAbstractListModel(parent),
+    m_syntacticAnalyzer(NULL)
+{}
+
+void UsedRulesListModel::setUsedRules(const SyntacticAnalyzer *syntacticAnalyzer)
+{
+    this->beginResetModel();
+    m_syntacticAnalyzer = syntacticAnalyzer;
+    m_usedRules = syntacticAnalyzer->usedRules();
+    this->endResetModel();
+}
+
+int UsedRulesListModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return m_usedRules.size();
+}
+
+QVariant UsedRulesListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || (index.row() >= m_usedRules.size()) || (role != Qt::DisplayRole))
+        return QVariant();
+    return m_syntacticAnalyzer->ruleText(m_usedRules.at(index.row()));
+}
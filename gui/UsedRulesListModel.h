@@ -0,0 +1,39 @@
+#ifndef USEDRULESLISTMODEL_H
+#define USEDRULESLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QVector>
+
+class SyntacticAnalyzer;
+
+/*!
+ * @brief This class used to show rules used by syntactic analyzer.
+ *
+ * Model stores only numbers of used rules, text of rule is made when view asks for it,
+ * so only visible rows are formatted.
+ */
+class UsedRulesListModel : public QAbstractListModel
+{
+
+public:
+
+    explicit UsedRulesListModel(QObject *parent = 0);
+
+    /*!
+     * This method used to set rules of last analysis.
+     *
+     * @param[in] syntacticAnalyzer Syntactic analyzer which made rule texts. It must live longer than model data.
+     */
+    void setUsedRules(const SyntacticAnalyzer *syntacticAnalyzer);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+
+private:
+
+    const SyntacticAnalyzer *m_syntacticAnalyzer;   //!< Syntactic analyzer which made rule texts.
+    QVector<int> m_usedRules;                       //!< Numbers of used rules.
+
+};
+
+#endif // USEDRULESLISTMODEL_H
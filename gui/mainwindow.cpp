@@ -2,40 +2,48 @@
 #include "ui_mainwindow.h"
 #include "FileReader.h"
 #include "Translator.h"
+#include "UsedRulesListModel.h"
+#include "SourceCodeHighlighter.h"
 #include <QTextStream>
 #include <QFile>
 #include <QFileDialog>
+#include <QTextCursor>
+#include <QTextDocumentFragment>
 #include <QTime>
 
 MainWindow::MainWindow(QWidget *parent) :
     QMainWindow(parent),
     ui(new Ui::MainWindow),
-    m_rulesStringListModel(new QStringListModel),
+    m_usedRulesListModel(new UsedRulesListModel),
     m_lexicalAnalyzerSettingsFileName(Translator::defaultLexicalAnalyzerSettingsFileName),
     m_syntacticAnalyzerSettingsFileName(Translator::defaultSyntacticAnalyzerSettingsFileName),
-    m_translator(new Translator)
+    m_translator(new Translator),
+    m_sourceCodeHighlighter(NULL)
 {
     ui->setupUi(this);
 
     connect(ui->sourceCodeInputTextEdit, SIGNAL(updateStatusBarSignal(int, int)), SLOT(updateStatusBarSlot(int, int)));
-    connect(ui->sourceCodeInputTextEdit, SIGNAL(updateTextByTimerSignal()), SLOT(updateSourceCodeInputTextEditSlot()));
+    connect(ui->sourceCodeInputTextEdit, SIGNAL(updateTextByTimerSignal(int, int, int)), SLOT(updateSourceCodeInputTextEditSlot(int, int, int)));
     connect(m_translator, SIGNAL(addToLog(QString)), this, SLOT(addToLog(QString)));
     connect(m_translator, SIGNAL(setTokenList(QString)), ui->tokenSequenceTextEdit, SLOT(setText(QString)));
-    connect(m_translator, SIGNAL(setRuleList(QStringList)), this, SLOT(setRuleList(QStringList)));
+    connect(m_translator, SIGNAL(setUsedRules(SyntacticAnalyzer*)), this, SLOT(setUsedRules(SyntacticAnalyzer*)));
     connect(m_translator, SIGNAL(setBlockTree(Block*)), this, SLOT(setBlockTree(Block*)));
     connect(m_translator, SIGNAL(setThreeAddressCode(QString)), ui->threeAddressCodeTextEdit, SLOT(setText(QString)));
 
     ui->tokenSequenceTextEdit->setFont(QFont("Courier New", 12));
     ui->rulesListView->setFont(QFont("Courier New", 12));
     ui->threeAddressCodeTextEdit->setFont(QFont("Courier New", 12));
-    ui->rulesListView->setModel(m_rulesStringListModel);
+    ui->rulesListView->setUniformItemSizes(true);
+    ui->rulesListView->setModel(m_usedRulesListModel);
 
     loadSettings();
+    m_sourceCodeHighlighter = new SourceCodeHighlighter(ui->sourceCodeInputTextEdit->document(), m_translator->lexicalAnalyzer());
 }
 
 MainWindow::~MainWindow()
 {
-    delete m_rulesStringListModel;
+    delete m_sourceCodeHighlighter;
+    delete m_usedRulesListModel;
     delete m_translator;
     delete ui;
 }
@@ -50,11 +58,17 @@ void MainWindow::updateStatusBarSlot(int line, int pos)
     ui->statusBar->showMessage(QString("\t(%1 : %2)").arg(pos).arg(line));
 }
 
-void MainWindow::updateSourceCodeInputTextEditSlot()
+void MainWindow::updateSourceCodeInputTextEditSlot(int position, int charsRemoved, int charsAdded)
 {
-    QString sourceCode = ui->sourceCodeInputTextEdit->toPlainText().toUpper();
-    QString markedUpSourceCode = m_translator->getMarkedUpSourceCode(sourceCode);
-    ui->sourceCodeInputTextEdit->setHtml(markedUpSourceCode);
+    // Only added characters are upper-cased and analyzed, highlighter marks up only changed lines
+    QTextCursor cursor(ui->sourceCodeInputTextEdit->document());
+    cursor.setPosition(position);
+    cursor.setPosition(position + charsAdded, QTextCursor::KeepAnchor);
+    QString addedText = cursor.selection().toPlainText();
+    QString upperCaseText = addedText.toUpper();
+    if (upperCaseText != addedText)
+        cursor.insertText(upperCaseText);
+    m_translator->retranslate(position, charsRemoved, upperCaseText);
 }
 
 void MainWindow::addToLog(const QString &log)
@@ -62,9 +76,9 @@ void MainWindow::addToLog(const QString &log)
     ui->compileOutputTextEdit->addHTMLString(log);
 }
 
-void MainWindow::setRuleList(const QStringList &ruleList)
+void MainWindow::setUsedRules(SyntacticAnalyzer *syntacticAnalyzer)
 {
-    m_rulesStringListModel->setStringList(ruleList);
+    m_usedRulesListModel->setUsedRules(syntacticAnalyzer);
 }
 
 void MainWindow::setBlockTree(Block *block)
@@ -74,13 +88,19 @@ void MainWindow::setBlockTree(Block *block)
 
 void MainWindow::loadSettings()
 {
-    if (!FileReader::isFileExist(m_lexicalAnalyzerSettingsFileName))
-        m_lexicalAnalyzerSettingsFileName = QFileDialog::getOpenFileName(this, tr("Open Settings File"), "LexicalAnalyzersSettings.json", tr("JSON (*.json)"));
-    FileReader::loadLexicalAnalyzerSettings(m_lexicalAnalyzerSettingsFileName, m_translator);
-
-    if (!FileReader::isFileExist(m_syntacticAnalyzerSettingsFileName))
-        m_syntacticAnalyzerSettingsFileName = QFileDialog::getOpenFileName(this, tr("Open Rules File"), "SyntacticAnalyzersSetting.rules", tr("RULES (*.rules)"));
-    FileReader::loadSyntacticAnalyzerRules(m_syntacticAnalyzerSettingsFileName, m_translator);
+    // Files of custom dialect are used instead of built-in dialect
+    bool hasDialectFiles = FileReader::isFileExist(m_lexicalAnalyzerSettingsFileName)
+            || FileReader::isFileExist(m_syntacticAnalyzerSettingsFileName);
+    if (hasDialectFiles || !FileReader::loadBuiltInDialect(m_translator)) {
+        if (!FileReader::isFileExist(m_lexicalAnalyzerSettingsFileName))
+            m_lexicalAnalyzerSettingsFileName = QFileDialog::getOpenFileName(this, tr("Open Settings File"), "LexicalAnalyzersSettings.json", tr("JSON (*.json)"));
+        FileReader::loadLexicalAnalyzerSettings(m_lexicalAnalyzerSettingsFileName, m_translator);
+
+        if (!FileReader::isFileExist(m_syntacticAnalyzerSettingsFileName))
+            m_syntacticAnalyzerSettingsFileName = QFileDialog::getOpenFileName(this, tr("Open Rules File"), "SyntacticAnalyzersSetting.rules", tr("RULES (*.rules)"));
+        FileReader::loadSyntacticAnalyzerRules(m_syntacticAnalyzerSettingsFileName, m_translator);
+    }
+    m_translator->logGrammarDiagnostics();
 
 }
 
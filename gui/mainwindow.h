@@ -11,10 +11,12 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
-#include <QStringListModel>
 
 class Translator;
 class Block;
+class SyntacticAnalyzer;
+class UsedRulesListModel;
+class SourceCodeHighlighter;
 
 namespace Ui {
 class MainWindow;
@@ -51,12 +53,16 @@ private slots:
     void updateStatusBarSlot(int line, int pos);
 
     /*!
-     * This slot used to update source code text.
+     * This slot used to update source code text after change. Only changed text is upper-cased and analyzed.
+     *
+     * @param[in] position Index of first changed character.
+     * @param[in] charsRemoved Count of removed characters.
+     * @param[in] charsAdded Count of added characters.
      */
-    void updateSourceCodeInputTextEditSlot();
+    void updateSourceCodeInputTextEditSlot(int position, int charsRemoved, int charsAdded);
 
     void addToLog(const QString& log);
-    void setRuleList(const QStringList& ruleList);
+    void setUsedRules(SyntacticAnalyzer *syntacticAnalyzer);
     void setBlockTree(Block *block);
 
 private:
@@ -70,10 +76,11 @@ private:
     void loadSettings();
 
     Ui::MainWindow *ui;                             //!< Main window.
-    QStringListModel* m_rulesStringListModel;
+    UsedRulesListModel *m_usedRulesListModel;
     QString m_lexicalAnalyzerSettingsFileName;
     QString m_syntacticAnalyzerSettingsFileName;
     Translator *m_translator;
+    SourceCodeHighlighter *m_sourceCodeHighlighter;  //!< Highlighter of source code, it uses lexical analyzer of translator.
 
 };
 
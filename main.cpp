@@ -1,9 +1,95 @@
 #include "mainwindow.h"
 #include <QApplication>
 #include <QDir>
+#include <QTextStream>
+#include "Translator.h"
+#include "FileReader.h"
+#include "LexicalAnalyzer.h"
+#include "SyntacticAnalyzer.h"
+#include "SemanticAnalyzer.h"
+#include "ThreeAddressCodeGenerator.h"
+
+/*!
+ * This function used to load dialect without main window. Dialect is loaded as by main window, but files
+ * of custom dialect are only taken from working directory.
+ *
+ * @param[in,out] translator Translator.
+ */
+static void LoadDialect(Translator &translator)
+{
+    bool hasDialectFiles = FileReader::isFileExist(Translator::defaultLexicalAnalyzerSettingsFileName)
+            || FileReader::isFileExist(Translator::defaultSyntacticAnalyzerSettingsFileName);
+    if (hasDialectFiles || !FileReader::loadBuiltInDialect(&translator)) {
+        FileReader::loadLexicalAnalyzerSettings(Translator::defaultLexicalAnalyzerSettingsFileName, &translator);
+        FileReader::loadSyntacticAnalyzerRules(Translator::defaultSyntacticAnalyzerSettingsFileName, &translator);
+    }
+}
+
+/*!
+ * This function used to translate source code file without main window. Errors are written to stderr.
+ *
+ * @param[in] fileName Source code file name.
+ * @return If file was translated returns 0 and writes three-address code to stdout other returns 1.
+ */
+static int TranslateFile(const QString &fileName)
+{
+    Translator translator;
+    LoadDialect(translator);
+    translator.translateFile(fileName);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    if (!translator.lexicalAnalyzerComplete())
+        err << "Lexical analyzer:\n" << translator.lexicalAnalyzer()->errorText() << "\n";
+    if (!translator.syntacticAnalyzerComplete())
+        err << "Syntactic analyzer:\n" << translator.syntacticAnalyzer()->errorText() << "\n";
+    if (translator.lexicalAnalyzerComplete() && translator.syntacticAnalyzerComplete()) {
+        if (!translator.semanticAnalyzerComplete())
+            err << "Semantic analyzer:\n" << translator.semanticAnalyzer()->errorText() << "\n";
+        if (!translator.threeAddressCodeGeneratorComplete())
+            err << "Code generator:\n" << translator.threeAddressCodeGenerator()->errorText() << "\n";
+    }
+    if (!translator.threeAddressCodeGeneratorComplete())
+        return 1;
+
+    out << translator.threeAddressCodeGenerator()->threeAddressCode();
+    return 0;
+}
+
+/*!
+ * This function used to check syntax of source code file without main window. File is not read to memory
+ * at once, so it can be bigger than memory. Errors are written to stderr.
+ *
+ * @param[in] fileName Source code file name.
+ * @return If syntax is correct returns 0 other returns 1.
+ */
+static int CheckFileSyntax(const QString &fileName)
+{
+    Translator translator;
+    LoadDialect(translator);
+    DiagnosticList diagnostics = translator.checkFileSyntax(fileName);
+    if (diagnostics.isEmpty())
+        return 0;
+
+    QTextStream err(stderr);
+    err << diagnostics.text() << "\n";
+    return 1;
+}
 
 int main(int argc, char *argv[])
 {
+    // Translator --translate <file> translates file without window
+    if ((argc == 3) && (QString::fromLocal8Bit(argv[1]) == "--translate")) {
+        QCoreApplication a(argc, argv);
+        return TranslateFile(QString::fromLocal8Bit(argv[2]));
+    }
+
+    // Translator --check <file> checks syntax of file without window
+    if ((argc == 3) && (QString::fromLocal8Bit(argv[1]) == "--check")) {
+        QCoreApplication a(argc, argv);
+        return CheckFileSyntax(QString::fromLocal8Bit(argv[2]));
+    }
+
     QDir appDir = QFileInfo(QString::fromLocal8Bit(argv[0])).absoluteDir();
     QString libPath = appDir.absolutePath() + "/plugins";
     QApplication::addLibraryPath(libPath);
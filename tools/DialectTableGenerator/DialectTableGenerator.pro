@@ -0,0 +1,55 @@
+#-------------------------------------------------
+#
+# Generator of built-in dialect tables.
+# Usage: DialectTableGenerator <settings.json> <rules.rules> <output.h>
+#
+#-------------------------------------------------
+
+QT       += core concurrent
+QT       -= gui
+
+TARGET = DialectTableGenerator
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG -= debug_and_release
+
+ROOT = $$PWD/../..
+
+INCLUDEPATH += $$ROOT
+INCLUDEPATH += $$ROOT/translator
+
+SOURCES += main.cpp \
+        $$ROOT/BackusNaurFormParser.cpp \
+        $$ROOT/BackusNaurFormRule.cpp \
+        $$ROOT/ErrorGenerator.cpp \
+        $$ROOT/translator/CharacterRunScanner.cpp \
+        $$ROOT/translator/Diagnostic.cpp \
+        $$ROOT/translator/Expression.cpp \
+        $$ROOT/translator/GeneratedParserContext.cpp \
+        $$ROOT/translator/Identifier.cpp \
+        $$ROOT/translator/LexicalAnalyzer.cpp \
+        $$ROOT/translator/LexicalTransitionTable.cpp \
+        $$ROOT/translator/NumberLiteral.cpp \
+        $$ROOT/translator/PerfectHash.cpp \
+        $$ROOT/translator/Production.cpp \
+        $$ROOT/translator/StringPool.cpp \
+        $$ROOT/translator/SyntacticAnalyzer.cpp \
+        $$ROOT/translator/SyntacticSymbol.cpp \
+        $$ROOT/translator/SyntaxTree.cpp \
+        $$ROOT/translator/TerminalIdTable.cpp \
+        $$ROOT/translator/Token.cpp \
+        $$ROOT/translator/TokenCursor.cpp \
+        $$ROOT/translator/TokenStream.cpp \
+        $$ROOT/translator/Utf8SourceCode.cpp
+
+HEADERS += $$ROOT/BackusNaurFormParser.h \
+        $$ROOT/BackusNaurFormRule.h \
+        $$ROOT/BuiltInDialect.h \
+        $$ROOT/translator/LexicalAnalyzer.h \
+        $$ROOT/translator/LexicalTransitionTable.h \
+        $$ROOT/translator/PerfectHash.h \
+        $$ROOT/translator/SyntacticAnalyzer.h \
+        $$ROOT/translator/SyntacticSymbol.h \
+        $$ROOT/translator/Token.h \
+        $$ROOT/translator/TerminalIdTable.h
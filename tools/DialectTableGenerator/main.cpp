@@ -0,0 +1,288 @@
+#include <QCoreApplication>
+#include <QStringList>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonValue>
+#include "BackusNaurFormParser.h"
+#include "LexicalAnalyzer.h"
+#include "SyntacticAnalyzer.h"
+
+/*!
+ * This function used to make C++ string literal. Characters out of ASCII are written as octal UTF-8 bytes.
+ *
+ * @param[in] string String.
+ * @return String literal.
+ */
+static QString MakeStringLiteral(const QString &string)
+{
+    QString literal = "\"";
+    const QByteArray bytes = string.toUtf8();
+    for (int i = 0; i < bytes.size(); i++) {
+        unsigned char character = static_cast<unsigned char>(bytes.at(i));
+        if ((character == '"') || (character == '\\'))
+            literal += QString("\\") + QChar(character);
+        else if ((character < 0x20) || (character >= 0x7F))
+            literal += QString("\\%1").arg(character, 3, 8, QChar('0'));
+        else
+            literal += QChar(character);
+    }
+    return literal + "\"";
+}
+
+/*!
+ * This function used to write array of strings. Array ends with NULL, so empty array is correct too.
+ *
+ * @param[out] out Stream of generated file.
+ * @param[in] name Name of array.
+ * @param[in] array JSON array of strings.
+ */
+static void WriteStringArray(QTextStream &out, const QString &name, const QJsonArray &array)
+{
+    out << "constexpr const char *" << name << "[] = {\n";
+    foreach (const QJsonValue &value, array)
+        out << "    " << MakeStringLiteral(value.toString()) << ",\n";
+    out << "    NULL\n};\n\n";
+}
+
+/*!
+ * This function used to write array of numbers. Array can't be empty, so empty array has one zero,
+ * its size is given by counts.
+ *
+ * @param[out] out Stream of generated file.
+ * @param[in] type Type of array element.
+ * @param[in] name Name of array.
+ * @param[in] array Numbers.
+ */
+template <typename Number>
+static void WriteNumberArray(QTextStream &out, const QString &type, const QString &name, const QVector<Number> &array)
+{
+    out << "constexpr " << type << " " << name << "[] = {";
+    for (int i = 0; i < array.size(); i++) {
+        out << ((i % 16 == 0) ? "\n    " : " ") << int(array.at(i));
+        if (i != array.size() - 1)
+            out << ",";
+    }
+    if (array.isEmpty())
+        out << "\n    0";
+    out << "\n};\n\n";
+}
+
+static void WriteBoolArray(QTextStream &out, const QString &name, const QVector<bool> &array)
+{
+    out << "constexpr bool " << name << "[] = {";
+    for (int i = 0; i < array.size(); i++) {
+        out << ((i % 16 == 0) ? "\n    " : " ") << (array.at(i) ? "true" : "false");
+        if (i != array.size() - 1)
+            out << ",";
+    }
+    if (array.isEmpty())
+        out << "\n    false";
+    out << "\n};\n\n";
+}
+
+static void WriteLexicalAnalyzerSettings(QTextStream &out, const QJsonObject &jsonObject)
+{
+    // Settings are read as in FileReader::loadLexicalAnalyzerSettings
+    out << "constexpr int BUILT_IN_MAX_NUMBER_LITERAL_LENGHT = " << jsonObject["maxNumberLiteralLenght"].toInt() << ";\n";
+    out << "constexpr int BUILT_IN_MAX_IDENTIFIER_NAME_LENGHT = " << jsonObject["maxIdentifierNameLenght"].toInt() << ";\n";
+    out << "constexpr int BUILT_IN_MAX_STRING_LITERAL_LENGHT = " << jsonObject["maxStringLiteralLenght"].toInt() << ";\n";
+    out << "constexpr const char *BUILT_IN_IDENTIFIER_REG_EXP = " << MakeStringLiteral(jsonObject["identifierRegExp"].toString()) << ";\n";
+    out << "constexpr const char *BUILT_IN_SPACE_REG_EXP = " << MakeStringLiteral(jsonObject["spaceRegExp"].toString()) << ";\n";
+    out << "constexpr const char *BUILT_IN_BEGIN_STRING_LITERAL = " << MakeStringLiteral(jsonObject["beginStringLiteral"].toString()) << ";\n\n";
+    WriteStringArray(out, "BUILT_IN_KEYWORDS", jsonObject["keywords"].toArray());
+    WriteStringArray(out, "BUILT_IN_CHARACTER_TOKENS", jsonObject["characterToken"].toArray());
+}
+
+static void LoadLexicalAnalyzerSettings(LexicalAnalyzer &lexicalAnalyzer, const QJsonObject &jsonObject)
+{
+    lexicalAnalyzer.setMaxNumberLiteralLenght(jsonObject["maxNumberLiteralLenght"].toInt());
+    lexicalAnalyzer.setMaxIdentifierNameLenght(jsonObject["maxIdentifierNameLenght"].toInt());
+    lexicalAnalyzer.setMaxStringLiteralLenght(jsonObject["maxStringLiteralLenght"].toInt());
+    lexicalAnalyzer.setIdentifierRegExp(QRegExp(jsonObject["identifierRegExp"].toString()));
+    lexicalAnalyzer.setSpaceRegExp(QRegExp(jsonObject["spaceRegExp"].toString()));
+    lexicalAnalyzer.setBeginStringLiteral(jsonObject["beginStringLiteral"].toString());
+    foreach (const QJsonValue &value, jsonObject["keywords"].toArray())
+        lexicalAnalyzer.addKeyword(value.toString());
+    foreach (const QJsonValue &value, jsonObject["characterToken"].toArray())
+        lexicalAnalyzer.addCharacterToken(value.toString());
+}
+
+/*!
+ * This function used to write compiled automaton and keywords perfect hash, so application doesn't compile
+ * settings at start.
+ *
+ * @param[out] out Stream of generated file.
+ * @param[in] lexicalAnalyzer Lexical analyzer with compiled transition table.
+ */
+static void WriteTransitionTable(QTextStream &out, const LexicalAnalyzer &lexicalAnalyzer)
+{
+    const LexicalTransitionTable &transitionTable = lexicalAnalyzer.transitionTable();
+    const int stateCount = transitionTable.stateCount();
+    const int characterClassCount = transitionTable.characterClassCount();
+    out << "constexpr int BUILT_IN_STATE_COUNT = " << stateCount << ";\n";
+    out << "constexpr int BUILT_IN_CHARACTER_CLASS_COUNT = " << characterClassCount << ";\n\n";
+
+    // Character run flag is set again when table is set
+    out << "constexpr BuiltInDialectState BUILT_IN_STATES[] = {\n";
+    for (int state = 0; state < stateCount; state++) {
+        out << "    {" << transitionTable.stateCategory(state)
+            << ", " << (transitionTable.stateFlags(state) & ~LexicalTransitionTable::CHARACTER_RUN_FLAG)
+            << ", " << transitionTable.stateType(state)
+            << ", " << transitionTable.stateError(state)
+            << ", " << lexicalAnalyzer.stateTerminalIds().at(state) << "},\n";
+    }
+    out << "    {0, 0, 0, 0, 0}\n};\n\n";
+
+    QVector<int> characterClasses(LexicalTransitionTable::COLUMN_COUNT);
+    for (int column = 0; column < LexicalTransitionTable::COLUMN_COUNT; column++)
+        characterClasses[column] = transitionTable.characterClass(LexicalTransitionTable::GetColumnRepresentative(column));
+    WriteNumberArray(out, "int", "BUILT_IN_CHARACTER_CLASSES", characterClasses);
+
+    QVector<int> transitions;
+    for (int state = 0; state < stateCount; state++) {
+        for (int characterClass = 0; characterClass < characterClassCount; characterClass++)
+            transitions << transitionTable.nextState(state, characterClass);
+    }
+    WriteNumberArray(out, "unsigned short", "BUILT_IN_TRANSITIONS", transitions);
+
+    QVector<bool> tokenEndClasses;
+    for (int characterClass = 0; characterClass < characterClassCount; characterClass++)
+        tokenEndClasses << transitionTable.isTokenEndClass(characterClass);
+    WriteBoolArray(out, "BUILT_IN_TOKEN_END_CLASSES", tokenEndClasses);
+
+    const PerfectHash &keywordPerfectHash = lexicalAnalyzer.keywordPerfectHash();
+    out << "constexpr int BUILT_IN_KEYWORD_COUNT = " << keywordPerfectHash.size() << ";\n\n";
+    out << "constexpr BuiltInDialectKeyword BUILT_IN_KEYWORD_SLOTS[] = {\n";
+    for (int i = 0; i < keywordPerfectHash.size(); i++) {
+        out << "    {" << MakeStringLiteral(keywordPerfectHash.key(i))
+            << ", " << keywordPerfectHash.seed(i)
+            << ", " << lexicalAnalyzer.keywordTypes().at(i)
+            << ", " << lexicalAnalyzer.keywordTerminalIds().at(i) << "},\n";
+    }
+    out << "    {NULL, 0, 0, 0}\n};\n\n";
+}
+
+/*!
+ * This function used to write parse table with FIRST and FOLLOW sets, so application doesn't calculate them
+ * at start. Conflicts of rules are written to show them in log as before.
+ *
+ * @param[out] out Stream of generated file.
+ * @param[in] syntacticAnalyzer Syntactic analyzer with built parse table.
+ */
+static void WriteParseTable(QTextStream &out, const SyntacticAnalyzer &syntacticAnalyzer)
+{
+    const int nonterminalCount = syntacticAnalyzer.nonterminalCount();
+    const int terminalCount = syntacticAnalyzer.terminalCount();
+    out << "constexpr int BUILT_IN_NONTERMINAL_COUNT = " << nonterminalCount << ";\n";
+    out << "constexpr int BUILT_IN_TERMINAL_COUNT = " << terminalCount << ";\n\n";
+
+    // Last column is end of source code
+    QVector<int> parseTable;
+    QVector<int> nullableRules;
+    QVector<bool> firstSets;
+    QVector<bool> followSets;
+    for (int nonterminal = 0; nonterminal < nonterminalCount; nonterminal++) {
+        for (int terminalId = 0; terminalId <= terminalCount; terminalId++) {
+            parseTable << syntacticAnalyzer.tableRule(nonterminal, terminalId);
+            firstSets << syntacticAnalyzer.isInFirstSet(nonterminal, terminalId);
+            followSets << syntacticAnalyzer.isInFollowSet(nonterminal, terminalId);
+        }
+        nullableRules << syntacticAnalyzer.nullableRule(nonterminal);
+    }
+    WriteNumberArray(out, "int", "BUILT_IN_PARSE_TABLE", parseTable);
+    WriteNumberArray(out, "int", "BUILT_IN_NULLABLE_RULES", nullableRules);
+    WriteBoolArray(out, "BUILT_IN_FIRST_SETS", firstSets);
+    WriteBoolArray(out, "BUILT_IN_FOLLOW_SETS", followSets);
+
+    const DiagnosticList &grammarDiagnostics = syntacticAnalyzer.grammarDiagnostics();
+    out << "constexpr BuiltInDialectConflict BUILT_IN_GRAMMAR_CONFLICTS[] = {\n";
+    for (int i = 0; i < grammarDiagnostics.size(); i++) {
+        const QStringList arguments = grammarDiagnostics.at(i).arguments();
+        out << "    {" << MakeStringLiteral(arguments.at(0))
+            << ", " << MakeStringLiteral(arguments.at(1))
+            << ", " << arguments.at(2)
+            << ", " << arguments.at(3) << "},\n";
+    }
+    out << "    {NULL, NULL, 0, 0}\n};\n\n";
+}
+
+static void WriteSymbol(QTextStream &out, const SyntacticSymbol &symbol)
+{
+    // Incorrect symbol (e.g. left part of line without "::=") has no name
+    QString name = symbol.isCorrect() ? MakeStringLiteral(symbol.name()) : QString("NULL");
+    out << "    {" << symbol.type() << ", " << symbol.category() << ", " << name << "},\n";
+}
+
+static void WriteSyntacticAnalyzerRules(QTextStream &out, const QList<BackusNaurFormRule> &rulesList)
+{
+    // Rules are parsed by the same parser as in FileReader::loadSyntacticAnalyzerRules
+    out << "constexpr BuiltInDialectSymbol BUILT_IN_SYMBOLS[] = {\n";
+    foreach (BackusNaurFormRule rule, rulesList) {
+        WriteSymbol(out, rule.leftPart());
+        foreach (SyntacticSymbol symbol, rule.rightPart())
+            WriteSymbol(out, symbol);
+    }
+    out << "    {0, 0, NULL}\n};\n\n";
+
+    int firstSymbol = 0;
+    out << "constexpr BuiltInDialectRule BUILT_IN_RULES[] = {\n";
+    foreach (BackusNaurFormRule rule, rulesList) {
+        int symbolCount = rule.rightPart().size() + 1;
+        out << "    {" << firstSymbol << ", " << symbolCount << "},\n";
+        firstSymbol += symbolCount;
+    }
+    out << "    {" << firstSymbol << ", 0}\n};\n\n";
+    out << "constexpr int BUILT_IN_RULE_COUNT = " << rulesList.size() << ";\n\n";
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication application(argc, argv);
+    QStringList arguments = application.arguments();
+    QTextStream errorStream(stderr);
+    if (arguments.size() != 4) {
+        errorStream << "Usage: DialectTableGenerator <settings.json> <rules.rules> <output.h>\n";
+        return 1;
+    }
+
+    QFile settingsFile(arguments.at(1));
+    QFile rulesFile(arguments.at(2));
+    if (!settingsFile.open(QIODevice::ReadOnly) || !rulesFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        errorStream << "Can't open dialect files\n";
+        return 1;
+    }
+    QJsonObject lexicalAnalyzerJsonObject = QJsonDocument::fromJson(settingsFile.readAll()).object()["LexicalAnalyser"].toObject();
+    QString rulesText = QTextStream(&rulesFile).readAll();
+    QList<BackusNaurFormRule> rulesList = BackusNaurFormParser::parse(rulesText);
+
+    // Tables are built as by FileReader, so rule numbers and terminal ids are the same
+    LexicalAnalyzer lexicalAnalyzer;
+    LoadLexicalAnalyzerSettings(lexicalAnalyzer, lexicalAnalyzerJsonObject);
+    SyntacticAnalyzer syntacticAnalyzer;
+    foreach (BackusNaurFormRule rule, rulesList)
+        syntacticAnalyzer.addProductRule(rule.leftPart(), rule.rightPart());
+    syntacticAnalyzer.buildParseTable();
+    lexicalAnalyzer.setTerminalIdTable(syntacticAnalyzer.terminalIdTable());
+    lexicalAnalyzer.compileTransitionTable();
+
+    QFile outputFile(arguments.at(3));
+    if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        errorStream << "Can't open file " << arguments.at(3) << "\n";
+        return 1;
+    }
+    QTextStream out(&outputFile);
+    out << "// Generated by DialectTableGenerator from " << QFileInfo(arguments.at(1)).fileName()
+        << " and " << QFileInfo(arguments.at(2)).fileName() << ". Do not edit.\n\n";
+    out << "#ifndef BUILTINDIALECTTABLES_H\n#define BUILTINDIALECTTABLES_H\n\n";
+    out << "#include <cstddef>\n#include \"BuiltInDialect.h\"\n\n";
+    WriteLexicalAnalyzerSettings(out, lexicalAnalyzerJsonObject);
+    WriteSyntacticAnalyzerRules(out, rulesList);
+    WriteTransitionTable(out, lexicalAnalyzer);
+    WriteParseTable(out, syntacticAnalyzer);
+    out << "#endif // BUILTINDIALECTTABLES_H\n";
+    return 0;
+}
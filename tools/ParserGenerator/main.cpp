@@ -0,0 +1,160 @@
+#include <QCoreApplication>
+#include <QStringList>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include "BackusNaurFormParser.h"
+#include "SyntacticAnalyzer.h"
+#include <algorithm>
+
+static QString FunctionName(int nonterminal)
+{
+    return QString("ParseNonterminal%1").arg(nonterminal);
+}
+
+/*!
+ * This function used to make text of rule for comment.
+ *
+ * @param[in] syntacticAnalyzer Syntactic analyzer with rules.
+ * @param[in] ruleNumber Number of rule.
+ * @return Rule text in one line.
+ */
+static QString RuleComment(const SyntacticAnalyzer &syntacticAnalyzer, int ruleNumber)
+{
+    return syntacticAnalyzer.ruleText(ruleNumber).replace('\t', ' ').trimmed();
+}
+
+/*!
+ * This function used to write parsing of rule right part. Last nonterminal which is the same as left part
+ * is parsed by next iteration of function loop, so lists of statements don't make deep recursion.
+ *
+ * @param[out] out Stream of generated file.
+ * @param[in] syntacticAnalyzer Syntactic analyzer with rules.
+ * @param[in] ruleNumber Number of rule.
+ * @param[in] indent Indent of code.
+ */
+static void WriteRule(QTextStream &out, const SyntacticAnalyzer &syntacticAnalyzer, int ruleNumber, const QString &indent)
+{
+    const QList<SyntacticSymbol> rightPart = syntacticAnalyzer.ruleRightPart(ruleNumber);
+    const int nonterminal = syntacticAnalyzer.ruleNonterminal(ruleNumber);
+    out << indent << "// " << RuleComment(syntacticAnalyzer, ruleNumber) << "\n";
+    out << indent << "int firstChild = context.useRule(node, " << ruleNumber << ");\n";
+    if (rightPart.isEmpty())
+        out << indent << "Q_UNUSED(firstChild);\n";
+    for (int i = 0; i < rightPart.size(); i++) {
+        const SyntacticSymbol &symbol = rightPart.at(i);
+        QString child = QString("context.child(firstChild, %1)").arg(i);
+        if (symbol.type() == SyntacticSymbol::TERMINAL_SYMBOL) {
+            out << indent << "if (!context.shift(" << child << ", " << symbol.terminalId() << "))\n";
+            out << indent << "    return false;\n";
+            continue;
+        }
+        int symbolNonterminal = syntacticAnalyzer.nonterminalIndex(symbol);
+        if ((i == rightPart.size() - 1) && (symbolNonterminal == nonterminal)) {
+            out << indent << "node = " << child << ";\n";
+            out << indent << "continue;\n";
+            return;
+        }
+        out << indent << "if (!" << FunctionName(symbolNonterminal) << "(context, " << child << "))\n";
+        out << indent << "    return false;\n";
+    }
+    out << indent << "return true;\n";
+}
+
+static void WriteNonterminalFunction(QTextStream &out, const SyntacticAnalyzer &syntacticAnalyzer, int nonterminal)
+{
+    // Rule for end column is used for unknown tokens and tokens which are parsed by it, other rules get cases
+    const int terminalCount = syntacticAnalyzer.terminalCount();
+    const int defaultRule = syntacticAnalyzer.tableRule(nonterminal, terminalCount);
+    QList<int> caseRules;
+    for (int terminalId = 0; terminalId < terminalCount; terminalId++) {
+        int ruleNumber = syntacticAnalyzer.tableRule(nonterminal, terminalId);
+        if ((ruleNumber >= 0) && (ruleNumber != defaultRule) && !caseRules.contains(ruleNumber))
+            caseRules << ruleNumber;
+    }
+    std::sort(caseRules.begin(), caseRules.end());
+
+    out << "// " << MakeStringRepresentation(syntacticAnalyzer.nonterminal(nonterminal)) << "\n";
+    out << "static bool " << FunctionName(nonterminal) << "(GeneratedParserContext &context, int node)\n{\n";
+    out << "    for (;;) {\n";
+    out << "        if (context.atEnd())\n";
+    out << "            return " << (syntacticAnalyzer.isNullableNonterminal(nonterminal) ? "true" : "false") << ";\n";
+    out << "        switch (context.terminalId()) {\n";
+    foreach (int ruleNumber, caseRules) {
+        for (int terminalId = 0; terminalId < terminalCount; terminalId++) {
+            if (syntacticAnalyzer.tableRule(nonterminal, terminalId) == ruleNumber)
+                out << "        case " << terminalId << ": // " << MakeStringRepresentation(syntacticAnalyzer.terminal(terminalId)) << "\n";
+        }
+        out << "        {\n";
+        WriteRule(out, syntacticAnalyzer, ruleNumber, "            ");
+        out << "        }\n";
+    }
+    out << "        default:\n";
+    if (defaultRule < 0) {
+        out << "            return false;\n";
+    } else {
+        out << "        {\n";
+        WriteRule(out, syntacticAnalyzer, defaultRule, "            ");
+        out << "        }\n";
+    }
+    out << "        }\n    }\n}\n\n";
+}
+
+static void WriteParser(QTextStream &out, const SyntacticAnalyzer &syntacticAnalyzer)
+{
+    out << "const int GENERATED_PARSER_RULE_COUNT = " << syntacticAnalyzer.ruleCount() << ";\n";
+    out << "const int GENERATED_PARSER_TERMINAL_COUNT = " << syntacticAnalyzer.terminalCount() << ";\n\n";
+
+    for (int nonterminal = 0; nonterminal < syntacticAnalyzer.nonterminalCount(); nonterminal++)
+        out << "static bool " << FunctionName(nonterminal) << "(GeneratedParserContext &context, int node);\n";
+    out << "\n";
+    for (int nonterminal = 0; nonterminal < syntacticAnalyzer.nonterminalCount(); nonterminal++)
+        WriteNonterminalFunction(out, syntacticAnalyzer, nonterminal);
+
+    int startNonterminal = syntacticAnalyzer.nonterminalIndex(SyntacticSymbol("S", SyntacticSymbol::START_SYMBOL));
+    out << "static bool ParseGeneratedDialect(GeneratedParserContext &context)\n{\n";
+    if (startNonterminal < 0)
+        out << "    Q_UNUSED(context);\n    return false;\n}\n\n";
+    else
+        out << "    return " << FunctionName(startNonterminal) << "(context, context.root()) && context.atEnd();\n}\n\n";
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication application(argc, argv);
+    QStringList arguments = application.arguments();
+    QTextStream errorStream(stderr);
+    if (arguments.size() != 3) {
+        errorStream << "Usage: ParserGenerator <rules.rules> <output.h>\n";
+        return 1;
+    }
+
+    QFile rulesFile(arguments.at(1));
+    if (!rulesFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        errorStream << "Can't open file " << arguments.at(1) << "\n";
+        return 1;
+    }
+    QString rulesText = QTextStream(&rulesFile).readAll();
+
+    // Rules are added in the same order as by FileReader, so rule numbers and terminal ids are the same
+    SyntacticAnalyzer syntacticAnalyzer;
+    foreach (BackusNaurFormRule rule, BackusNaurFormParser::parse(rulesText))
+        syntacticAnalyzer.addProductRule(rule.leftPart(), rule.rightPart());
+    syntacticAnalyzer.buildParseTable();
+    if (!syntacticAnalyzer.grammarDiagnostics().isEmpty())
+        errorStream << "Grammar is not LL(1), first of conflicting rules is used:\n" << syntacticAnalyzer.grammarDiagnostics().text();
+
+    QFile outputFile(arguments.at(2));
+    if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        errorStream << "Can't open file " << arguments.at(2) << "\n";
+        return 1;
+    }
+    QTextStream out(&outputFile);
+    out.setCodec("UTF-8");
+    out << "// Generated by ParserGenerator from " << QFileInfo(arguments.at(1)).fileName() << ". Do not edit.\n\n";
+    out << "#ifndef GENERATEDPARSER_H\n#define GENERATEDPARSER_H\n\n";
+    out << "#include <QtGlobal>\n#include \"GeneratedParserContext.h\"\n\n";
+    WriteParser(out, syntacticAnalyzer);
+    out << "#endif // GENERATEDPARSER_H\n";
+    return 0;
+}
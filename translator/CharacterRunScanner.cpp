@@ -0,0 +1,224 @@
+#include "CharacterRunScanner.h"
+
+#if defined(Q_PROCESSOR_X86) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define CHARACTER_RUN_SSE2
+#include <emmintrin.h>
+#if defined(Q_CC_MSVC) || defined(Q_CC_CLANG) || (defined(Q_CC_GNU) && (Q_CC_GNU >= 409))
+#define CHARACTER_RUN_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+#if defined(Q_CC_MSVC)
+#include <intrin.h>
+#endif
+
+#if defined(CHARACTER_RUN_AVX2) && !defined(Q_CC_MSVC)
+// Only AVX2 functions are compiled for AVX2, so binary still runs on processors without it
+#define CHARACTER_RUN_AVX2_FUNCTION __attribute__((target("avx2")))
+#else
+#define CHARACTER_RUN_AVX2_FUNCTION
+#endif
+
+typedef int (*ByteRunEndFunction)(const quint8 *data, int index, int endIndex,
+                                  const quint8 *firstCharacters, const quint8 *rangeWidths, int rangeCount);
+typedef int (*WordRunEndFunction)(const quint16 *data, int index, int endIndex,
+                                  const quint8 *firstCharacters, const quint8 *rangeWidths, int rangeCount);
+
+/*!
+ * @brief This structure used to store run scanning functions for instruction set of processor.
+ */
+struct RunEndFunctions
+{
+    ByteRunEndFunction byteRunEnd;      //!< Function for UTF-8 bytes.
+    WordRunEndFunction wordRunEnd;      //!< Function for QString characters.
+    const char *instructionSetName;     //!< Name of instruction set.
+};
+
+template <typename Unit>
+static int ScalarRunEnd(const Unit *data, int index, int endIndex,
+                        const quint8 *firstCharacters, const quint8 *rangeWidths, int rangeCount)
+{
+    for (; index < endIndex; index++) {
+        const uint code = data[index];
+        bool isInRun = false;
+        for (int i = 0; (i < rangeCount) && !isInRun; i++)
+            isInRun = (code - firstCharacters[i] <= rangeWidths[i]);
+        if (!isInRun)
+            break;
+    }
+    return index;
+}
+
+#if defined(CHARACTER_RUN_SSE2)
+
+static inline int CountTrailingZeroBits(uint value)
+{
+#if defined(Q_CC_MSVC)
+    unsigned long bitIndex;
+    _BitScanForward(&bitIndex, value);
+    return int(bitIndex);
+#else
+    return __builtin_ctz(value);
+#endif
+}
+
+// Unit is in range when saturated (unit - first) - width is zero
+template <typename Unit>
+static int Sse2RunEnd(const Unit *data, int index, int endIndex,
+                      const quint8 *firstCharacters, const quint8 *rangeWidths, int rangeCount)
+{
+    const int unitCount = int(sizeof(__m128i) / sizeof(Unit));
+    const __m128i zero = _mm_setzero_si128();
+    __m128i firstUnits[CharacterRunScanner::MAX_RANGE_COUNT];
+    __m128i widthUnits[CharacterRunScanner::MAX_RANGE_COUNT];
+    for (int i = 0; i < rangeCount; i++) {
+        firstUnits[i] = (sizeof(Unit) == 1) ? _mm_set1_epi8(char(firstCharacters[i])) : _mm_set1_epi16(short(firstCharacters[i]));
+        widthUnits[i] = (sizeof(Unit) == 1) ? _mm_set1_epi8(char(rangeWidths[i])) : _mm_set1_epi16(short(rangeWidths[i]));
+    }
+
+    while (index + unitCount <= endIndex) {
+        const __m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + index));
+        __m128i inRun = zero;
+        for (int i = 0; i < rangeCount; i++) {
+            if (sizeof(Unit) == 1) {
+                const __m128i excess = _mm_subs_epu8(_mm_sub_epi8(units, firstUnits[i]), widthUnits[i]);
+                inRun = _mm_or_si128(inRun, _mm_cmpeq_epi8(excess, zero));
+            } else {
+                const __m128i excess = _mm_subs_epu16(_mm_sub_epi16(units, firstUnits[i]), widthUnits[i]);
+                inRun = _mm_or_si128(inRun, _mm_cmpeq_epi16(excess, zero));
+            }
+        }
+        // Mask has one bit for every byte
+        const uint outOfRunMask = ~uint(_mm_movemask_epi8(inRun)) & 0xFFFFu;
+        if (outOfRunMask != 0)
+            return index + CountTrailingZeroBits(outOfRunMask) / int(sizeof(Unit));
+        index += unitCount;
+    }
+    return ScalarRunEnd(data, index, endIndex, firstCharacters, rangeWidths, rangeCount);
+}
+
+#endif
+
+#if defined(CHARACTER_RUN_AVX2)
+
+template <typename Unit>
+CHARACTER_RUN_AVX2_FUNCTION
+static int Avx2RunEnd(const Unit *data, int index, int endIndex,
+                      const quint8 *firstCharacters, const quint8 *rangeWidths, int rangeCount)
+{
+    const int unitCount = int(sizeof(__m256i) / sizeof(Unit));
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i firstUnits[CharacterRunScanner::MAX_RANGE_COUNT];
+    __m256i widthUnits[CharacterRunScanner::MAX_RANGE_COUNT];
+    for (int i = 0; i < rangeCount; i++) {
+        firstUnits[i] = (sizeof(Unit) == 1) ? _mm256_set1_epi8(char(firstCharacters[i])) : _mm256_set1_epi16(short(firstCharacters[i]));
+        widthUnits[i] = (sizeof(Unit) == 1) ? _mm256_set1_epi8(char(rangeWidths[i])) : _mm256_set1_epi16(short(rangeWidths[i]));
+    }
+
+    while (index + unitCount <= endIndex) {
+        const __m256i units = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + index));
+        __m256i inRun = zero;
+        for (int i = 0; i < rangeCount; i++) {
+            if (sizeof(Unit) == 1) {
+                const __m256i excess = _mm256_subs_epu8(_mm256_sub_epi8(units, firstUnits[i]), widthUnits[i]);
+                inRun = _mm256_or_si256(inRun, _mm256_cmpeq_epi8(excess, zero));
+            } else {
+                const __m256i excess = _mm256_subs_epu16(_mm256_sub_epi16(units, firstUnits[i]), widthUnits[i]);
+                inRun = _mm256_or_si256(inRun, _mm256_cmpeq_epi16(excess, zero));
+            }
+        }
+        const uint outOfRunMask = ~uint(_mm256_movemask_epi8(inRun));
+        if (outOfRunMask != 0)
+            return index + CountTrailingZeroBits(outOfRunMask) / int(sizeof(Unit));
+        index += unitCount;
+    }
+    return Sse2RunEnd(data, index, endIndex, firstCharacters, rangeWidths, rangeCount);
+}
+
+static bool IsAvx2Supported()
+{
+#if defined(Q_CC_MSVC)
+    int cpuInfo[4];
+    __cpuid(cpuInfo, 0);
+    if (cpuInfo[0] < 7)
+        return false;
+    // AVX registers must be saved by operating system (OSXSAVE, AVX and XCR0 bits)
+    __cpuid(cpuInfo, 1);
+    if ((cpuInfo[2] & 0x18000000) != 0x18000000)
+        return false;
+    if ((_xgetbv(0) & 0x6) != 0x6)
+        return false;
+    __cpuidex(cpuInfo, 7, 0);
+    return (cpuInfo[1] & 0x20) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif
+
+static RunEndFunctions SelectRunEndFunctions()
+{
+    RunEndFunctions functions;
+    functions.byteRunEnd = &ScalarRunEnd<quint8>;
+    functions.wordRunEnd = &ScalarRunEnd<quint16>;
+    functions.instructionSetName = "scalar";
+#if defined(CHARACTER_RUN_SSE2)
+    functions.byteRunEnd = &Sse2RunEnd<quint8>;
+    functions.wordRunEnd = &Sse2RunEnd<quint16>;
+    functions.instructionSetName = "SSE2";
+#endif
+#if defined(CHARACTER_RUN_AVX2)
+    if (IsAvx2Supported()) {
+        functions.byteRunEnd = &Avx2RunEnd<quint8>;
+        functions.wordRunEnd = &Avx2RunEnd<quint16>;
+        functions.instructionSetName = "AVX2";
+    }
+#endif
+    return functions;
+}
+
+static const RunEndFunctions &SelectedRunEndFunctions()
+{
+    static const RunEndFunctions functions = SelectRunEndFunctions();
+    return functions;
+}
+
+CharacterRunScanner::CharacterRunScanner() :
+    m_rangeCount(0)
+{}
+
+bool CharacterRunScanner::addRange(uchar firstCharacter, uchar lastCharacter)
+{
+    Q_ASSERT((firstCharacter <= lastCharacter) && (lastCharacter < 0x80));
+    if (m_rangeCount == MAX_RANGE_COUNT)
+        return false;
+    m_firstCharacters[m_rangeCount] = firstCharacter;
+    m_rangeWidths[m_rangeCount] = lastCharacter - firstCharacter;
+    m_rangeCount++;
+    return true;
+}
+
+bool CharacterRunScanner::isEmpty() const
+{
+    return m_rangeCount == 0;
+}
+
+int CharacterRunScanner::runEnd(const QChar *data, int index, int endIndex) const
+{
+    return SelectedRunEndFunctions().wordRunEnd(reinterpret_cast<const quint16 *>(data), index, endIndex,
+                                                m_firstCharacters, m_rangeWidths, m_rangeCount);
+}
+
+int CharacterRunScanner::runEnd(const char *data, int index, int endIndex) const
+{
+    return SelectedRunEndFunctions().byteRunEnd(reinterpret_cast<const quint8 *>(data), index, endIndex,
+                                                m_firstCharacters, m_rangeWidths, m_rangeCount);
+}
+
+const char *CharacterRunScanner::InstructionSetName()
+{
+    return SelectedRunEndFunctions().instructionSetName;
+}
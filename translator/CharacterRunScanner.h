@@ -0,0 +1,69 @@
+#ifndef CHARACTERRUNSCANNER_H
+#define CHARACTERRUNSCANNER_H
+
+#include <QChar>
+#include <QtGlobal>
+
+/*!
+ * @brief This class used to find end of run of ASCII characters which belong to a few character ranges.
+ *
+ * Lexical analyzer uses it for states which stay the same on many characters (e.g. spaces, identifiers,
+ * digits or string literal). Run is checked by 32 or 16 characters at a time with AVX2 or SSE2 instructions,
+ * instruction set is chosen at runtime, other processors use scalar loop.
+ */
+class CharacterRunScanner
+{
+
+public:
+
+    static const int MAX_RANGE_COUNT = 4;   //!< Count of ranges which are checked together.
+
+    CharacterRunScanner();
+
+    /*!
+     * This method used to add range of characters to run.
+     *
+     * @param[in] firstCharacter First character of range.
+     * @param[in] lastCharacter Last character of range. Range must be in ASCII.
+     * @return If range was added returns true other returns false. (e.g. when there are too many ranges)
+     */
+    bool addRange(uchar firstCharacter, uchar lastCharacter);
+
+    bool isEmpty() const;
+
+    /*!
+     * This method returns index of first character which is not in run.
+     *
+     * @param[in] data Characters of source code.
+     * @param[in] index Index of first character to check.
+     * @param[in] endIndex Index of source code end.
+     * @return Index of first character out of ranges or endIndex.
+     */
+    int runEnd(const QChar *data, int index, int endIndex) const;
+
+    /*!
+     * This method returns index of first byte which is not in run. Bytes of not ASCII characters are never in run.
+     *
+     * @param[in] data Bytes of source code.
+     * @param[in] index Index of first byte to check.
+     * @param[in] endIndex Index of source code end.
+     * @return Index of first byte out of ranges or endIndex.
+     */
+    int runEnd(const char *data, int index, int endIndex) const;
+
+    /*!
+     * This method returns name of instruction set which is used on this processor.
+     *
+     * @return "AVX2", "SSE2" or "scalar".
+     */
+    static const char *InstructionSetName();
+
+private:
+
+    quint8 m_firstCharacters[MAX_RANGE_COUNT];  //!< First character of each range.
+    quint8 m_rangeWidths[MAX_RANGE_COUNT];      //!< Last character minus first character of each range.
+    int m_rangeCount;                           //!< Count of ranges.
+
+};
+
+#endif // CHARACTERRUNSCANNER_H
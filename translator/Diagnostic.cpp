@@ -0,0 +1,77 @@
+#include "Diagnostic.h"
+#include "ErrorGenerator.h"
+
+Diagnostic::Diagnostic() :
+    m_stage(LEXICAL_STAGE),
+    m_code(UNKNOWN_STRING_ERROR)
+{}
+
+Diagnostic::Diagnostic(Stage stage, Code code, const QPoint &position, const QStringList &arguments) :
+    m_stage(stage),
+    m_code(code),
+    m_position(position),
+    m_arguments(arguments)
+{}
+
+Diagnostic::Stage Diagnostic::stage() const
+{
+    return Stage(m_stage);
+}
+
+Diagnostic::Code Diagnostic::code() const
+{
+    return Code(m_code);
+}
+
+QPoint Diagnostic::position() const
+{
+    return m_position;
+}
+
+QStringList Diagnostic::arguments() const
+{
+    return m_arguments;
+}
+
+void DiagnosticList::append(const Diagnostic &diagnostic)
+{
+    m_diagnostics.append(diagnostic);
+}
+
+void DiagnosticList::append(const DiagnosticList &other)
+{
+    m_diagnostics += other.m_diagnostics;
+}
+
+void DiagnosticList::clear()
+{
+    m_diagnostics.clear();
+}
+
+int DiagnosticList::size() const
+{
+    return m_diagnostics.size();
+}
+
+bool DiagnosticList::isEmpty() const
+{
+    return m_diagnostics.isEmpty();
+}
+
+Diagnostic DiagnosticList::at(int index) const
+{
+    return m_diagnostics.at(index);
+}
+
+QString DiagnosticList::text() const
+{
+    QString errorText;
+    int errorNumber = 1;
+    foreach (Diagnostic diagnostic, m_diagnostics) {
+        // Code generator errors are not numbered
+        if (diagnostic.stage() != Diagnostic::CODE_GENERATION_STAGE)
+            errorText += QString("%1:\t").arg(errorNumber++);
+        errorText += ErrorGenerator::message(diagnostic) + "\n";
+    }
+    return errorText;
+}
@@ -0,0 +1,102 @@
+#ifndef DIAGNOSTIC_H
+#define DIAGNOSTIC_H
+
+#include <QString>
+#include <QStringList>
+#include <QPoint>
+#include <QVector>
+#include <QtGlobal>
+
+/*!
+ * @brief This class used to store information about one error of translation.
+ *
+ * Diagnostic stores only stage, error code, position and arguments (e.g. lexemes). Message is made by
+ * ErrorGenerator only when error text is needed.
+ */
+class Diagnostic
+{
+
+public:
+
+    /*!
+     * @brief This enumerate include stages of translation.
+     */
+    enum Stage {
+        LEXICAL_STAGE,
+        SYNTACTIC_STAGE,
+        SEMANTIC_STAGE,
+        CODE_GENERATION_STAGE
+    };
+
+    /*!
+     * @brief This enumerate include errors codes.
+     */
+    enum Code {
+        FILE_OPEN_ERROR,                    //!< Arguments: file name.
+        UNKNOWN_STRING_ERROR,               //!< Arguments: lexeme, error information.
+        NUMBER_OVERFLOW_ERROR,              //!< Arguments: lexeme.
+        NUMBER_PRECISION_ERROR,             //!< Arguments: lexeme.
+        EMPTY_SYNTACTIC_ERROR,              //!< No arguments.
+        MISSING_CHARACTER_ERROR,            //!< Arguments: symbol.
+        NO_RULE_FOR_TOKEN_ERROR,            //!< Arguments: token.
+        MISSING_SYMBOL_ERROR,               //!< Arguments: symbol.
+        NO_RULE_FOR_SYMBOL_ERROR,           //!< Arguments: symbol, token.
+        UNDECLARED_IDENTIFIER_ERROR,        //!< Arguments: identifier.
+        REDECLARED_IDENTIFIER_ERROR,        //!< Arguments: identifier.
+        INCORRECT_ASSIGNMENT_TYPE_ERROR,    //!< No arguments.
+        INCORRECT_IDENTIFIER_ERROR,         //!< No arguments.
+        INCORRECT_OPERATION_ERROR,          //!< Arguments: operation, first operand, second operand.
+        GRAMMAR_CONFLICT_ERROR,             //!< Arguments: nonterminal, terminal, first rule number, second rule number.
+        INCORRECT_DECLARATION_ERROR         //!< Arguments: declaration keyword.
+    };
+
+    Diagnostic();
+    Diagnostic(Stage stage, Code code, const QPoint &position = QPoint(), const QStringList &arguments = QStringList());
+
+    Stage stage() const;
+    Code code() const;
+    QPoint position() const;
+    QStringList arguments() const;
+
+private:
+
+    quint8 m_stage;             //!< Stage of translation.
+    quint8 m_code;              //!< Error code.
+    QPoint m_position;          //!< Position of error in source code.
+    QStringList m_arguments;    //!< Arguments of message.
+
+};
+
+/*!
+ * @brief This class used to collect errors of translation stage.
+ *
+ * Errors are appended to vector, so collecting does not depend on count of errors before.
+ * Numbered error text is made only when it is needed. (e.g. for log)
+ */
+class DiagnosticList
+{
+
+public:
+
+    void append(const Diagnostic &diagnostic);
+    void append(const DiagnosticList &other);
+    void clear();
+
+    int size() const;
+    bool isEmpty() const;
+    Diagnostic at(int index) const;
+
+    /*!
+     * This method used to make errors text. Errors of analyzers are numbered, each error is on its own line.
+     *
+     * @return Errors string.
+     */
+    QString text() const;
+
+private:
+
+    QVector<Diagnostic> m_diagnostics;  //!< Errors in order of adding.
+
+};
+
+#endif // DIAGNOSTIC_H
@@ -95,7 +95,7 @@ void Expression::makeThreeAddressCode()
             Token newToken = Token(QString("t%1").arg(m_codeList.size()), Token::IDENTIFIER_CATEGORY);
             Expression::Type newType = resultType(currentToken, firstToken, secondToken);
             if (newType == Expression::NONE_TYPE) {
-                m_error +=  ErrorGenerator::cantDoOperation(currentToken, firstToken, secondToken);
+                m_diagnostics.append(ErrorGenerator::cantDoOperation(currentToken, firstToken, secondToken));
                 return;
             }
             newToken.setType(newType);
@@ -109,9 +109,9 @@ void Expression::makeThreeAddressCode()
     }
 }
 
-QString Expression::error() const
+DiagnosticList Expression::diagnostics() const
 {
-    return m_error;
+    return m_diagnostics;
 }
 
 QString Expression::codeList() const
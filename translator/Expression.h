@@ -2,6 +2,7 @@
 #define EXPRESSION_H
 #include <QList>
 #include <QString>
+#include "Diagnostic.h"
 
 class Token;
 class Expression
@@ -22,7 +23,7 @@ public:
 
     QString codeList() const;
 
-    QString error() const;
+    DiagnosticList diagnostics() const;
 
 private:
 
@@ -34,7 +35,7 @@ private:
     QList<QString> m_codeList;
 
     QList<Token> m_stack;
-    QString m_error;
+    DiagnosticList m_diagnostics;
 };
 
 #endif // EXPRESSION_H
@@ -0,0 +1,48 @@
+#include "GeneratedParserContext.h"
+#include "SyntacticAnalyzer.h"
+#include "TokenCursor.h"
+
+GeneratedParserContext::GeneratedParserContext(SyntacticAnalyzer *syntacticAnalyzer, TokenCursor *tokenCursor) :
+    m_syntacticAnalyzer(syntacticAnalyzer),
+    m_tokenCursor(tokenCursor)
+{}
+
+bool GeneratedParserContext::atEnd()
+{
+    return m_tokenCursor->atEnd();
+}
+
+int GeneratedParserContext::terminalId()
+{
+    return m_tokenCursor->peekTerminalId();
+}
+
+int GeneratedParserContext::root() const
+{
+    return m_syntacticAnalyzer->m_syntaxTree.root();
+}
+
+int GeneratedParserContext::useRule(int node, int ruleNumber)
+{
+    int firstChild = -1;
+    if (m_syntacticAnalyzer->m_isSyntaxTreeEnabled) {
+        firstChild = m_syntacticAnalyzer->m_syntaxTree.addChildren(node,
+                                                                   ruleNumber,
+                                                                   m_syntacticAnalyzer->m_productions.at(ruleNumber).syntacticSymbolList());
+    }
+    m_syntacticAnalyzer->useRule(ruleNumber);
+    return firstChild;
+}
+
+bool GeneratedParserContext::shift(int node, int terminalId)
+{
+    // Line feed at the end of source code is skipped as by table analysis
+    if (m_tokenCursor->atEnd())
+        return m_syntacticAnalyzer->m_terminals.at(terminalId).category() == Token::LINE_FEED_CATEGORY;
+    if (m_tokenCursor->peekTerminalId() != terminalId)
+        return false;
+    if (m_syntacticAnalyzer->m_isSyntaxTreeEnabled)
+        m_syntacticAnalyzer->m_syntaxTree.setTokenIndex(node, m_syntacticAnalyzer->m_tokenIndex);
+    m_syntacticAnalyzer->skipToken(*m_tokenCursor);
+    return true;
+}
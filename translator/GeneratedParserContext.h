@@ -0,0 +1,69 @@
+#ifndef GENERATEDPARSERCONTEXT_H
+#define GENERATEDPARSERCONTEXT_H
+
+class SyntacticAnalyzer;
+class TokenCursor;
+
+/*!
+ * @brief This class used to run parser which is generated by ParserGenerator (see tools) from production rules.
+ *
+ * Generated parser has function for every nonterminal which chooses rule by terminal id of token. Functions
+ * call this class to read tokens and to record used rules, so trace and syntax tree are the same as after
+ * table analysis. Generated parser only accepts correct source code, syntax errors are found by table analysis.
+ */
+class GeneratedParserContext
+{
+
+public:
+
+    GeneratedParserContext(SyntacticAnalyzer *syntacticAnalyzer, TokenCursor *tokenCursor);
+
+    bool atEnd();
+    int terminalId();
+
+    /*!
+     * This method returns syntax tree node of start symbol.
+     *
+     * @return Index of node or -1 if syntax tree is not built.
+     */
+    int root() const;
+
+    /*!
+     * This method used to record rule which is used to parse nonterminal.
+     *
+     * @param[in] node Syntax tree node of nonterminal.
+     * @param[in] ruleNumber Number of rule.
+     * @return Syntax tree node of first symbol of rule right part or -1 if syntax tree is not built.
+     */
+    int useRule(int node, int ruleNumber);
+
+    /*!
+     * This method used to parse token as terminal. Line feed can be missed at the end of source code.
+     *
+     * @param[in] node Syntax tree node of terminal.
+     * @param[in] terminalId Terminal id.
+     * @return If token is parsed returns true other returns false.
+     */
+    bool shift(int node, int terminalId);
+
+    inline int child(int firstChild, int position) const
+    {
+        return (firstChild < 0) ? -1 : firstChild + position;
+    }
+
+private:
+
+    SyntacticAnalyzer *m_syntacticAnalyzer; //!< Syntactic analyzer which records rules.
+    TokenCursor *m_tokenCursor;             //!< Cursor of tokens.
+
+};
+
+/*!
+ * Type of generated parser function.
+ *
+ * @param[in,out] context Context of parser.
+ * @return If source code is correct returns true other returns false.
+ */
+typedef bool (*GeneratedParser)(GeneratedParserContext &context);
+
+#endif // GENERATEDPARSERCONTEXT_H
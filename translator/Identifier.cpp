@@ -2,14 +2,16 @@
 
 Identifier::Identifier(const Identifier &newIdentifier) :
     m_lexeme(newIdentifier.lexeme()),
+    m_lexemeId(newIdentifier.lexemeId()),
     m_type(newIdentifier.type()),
     m_scopeBeginLineNumber(newIdentifier.scopeBeginLineNumber()),
     m_scopeEndLineNumber(newIdentifier.scopeEndLineNumber()),
     m_code(newIdentifier.code())
 {}
 
-Identifier::Identifier(const QString &lexeme, Expression::Type type, int scopeBeginLineNumber, int scopeEndLineNumber) :
+Identifier::Identifier(const QString &lexeme, Expression::Type type, int scopeBeginLineNumber, int scopeEndLineNumber, int lexemeId) :
     m_lexeme(lexeme),
+    m_lexemeId(lexemeId),
     m_type(type),
     m_scopeBeginLineNumber(scopeBeginLineNumber),
     m_scopeEndLineNumber(scopeEndLineNumber)
@@ -17,6 +19,8 @@ Identifier::Identifier(const QString &lexeme, Expression::Type type, int scopeBe
 
 bool Identifier::operator==(const Identifier &otherIdentifier) const
 {
+    if ((m_lexemeId >= 0) && (otherIdentifier.lexemeId() >= 0))
+        return m_lexemeId == otherIdentifier.lexemeId();
     return m_lexeme == otherIdentifier.lexeme();
 }
 
@@ -50,6 +54,11 @@ QString Identifier::lexeme() const
     return m_lexeme;
 }
 
+int Identifier::lexemeId() const
+{
+    return m_lexemeId;
+}
+
 Expression::Type StringToType(QString lexeme)
 {
     if (lexeme == "INTEGER") {
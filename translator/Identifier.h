@@ -25,9 +25,16 @@ public:
 
     Identifier(){}
     Identifier(const Identifier &other);
-    Identifier(const QString &lexeme, Expression::Type type, int scopeBeginLineNumber, int scopeEndLineNumber);
+    Identifier(const QString &lexeme, Expression::Type type, int scopeBeginLineNumber, int scopeEndLineNumber, int lexemeId = -1);
 
     QString lexeme() const;
+
+    /*!
+     * This method returns interned id of identifiers name.
+     *
+     * @return Id of name in string pool or -1 if name is not interned.
+     */
+    int lexemeId() const;
     bool operator==(const Identifier &otherIdentifier)const;
 
     Expression::Type type() const;
@@ -40,6 +47,7 @@ public:
 private:
 
     QString m_lexeme;               //!< Identifiers name.
+    int m_lexemeId;                 //!< Identifiers name id in string pool.
     Expression::Type m_type;        //!< Identifiers type.
     int m_scopeBeginLineNumber;     //!< Identifiers scope begin line number.
     int m_scopeEndLineNumber;       //!< Identifiers scope end line number.
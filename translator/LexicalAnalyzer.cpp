@@ -1,41 +1,51 @@
 #include "LexicalAnalyzer.h"
 #include "ErrorGenerator.h"
 #include <QStringList>
+#include <QSet>
+#include <QThread>
+#include <QtConcurrentMap>
 #include "Token.h"
+#include "SourceText.h"
 
-LexicalAnalyzer::LexicalAnalyzer() :
-    m_possibleTokenEndRegExp(QRegExp("( |\t|\n)")),
-    m_maxCharacterTokensLenght(0)
-{}
-
-void LexicalAnalyzer::analyzeLine(const QString &line, int lineNumber)
+static Token::LexicalError GetTooLongLexemeError(Token::TokenCategory category)
 {
-    int tokenBeginIndexInLine = 0;
-    while (tokenBeginIndexInLine < line.length()) {
-        Token nextToken = this->getNextToken(QPoint(tokenBeginIndexInLine, lineNumber), line.mid(tokenBeginIndexInLine));
-        m_tokenList.append(nextToken);
-        tokenBeginIndexInLine += nextToken.lexeme().length();
+    switch (category) {
+    case Token::NUMBER_LITERAL_CATEGORY:
+        return Token::NUMBER_TOO_LONG_ERROR;
+    case Token::IDENTIFIER_CATEGORY:
+        return Token::IDENTIFIER_TOO_LONG_ERROR;
+    case Token::STRING_LITERAL_CATEGORY:
+        return Token::STRING_TOO_LONG_ERROR;
+    default:
+        return Token::UNKNOWN_STRING_ERROR;
     }
 }
 
-void LexicalAnalyzer::addError(const QString &error)
-{
-    m_errorText += QString("%1:\t").arg(m_errorText.split("\n").count()) + error + "\n";
-}
+LexicalAnalyzer::LexicalAnalyzer() :
+    m_isDiagnosticsUpdated(true),
+    m_incorrectTokenCount(0),
+    m_isTransitionTableCompiled(false),
+    m_isParallelAnalysisEnabled(true),
+    m_changedTokenIndex(0),
+    m_removedTokenCount(0),
+    m_addedTokenCount(0)
+{}
 
-void LexicalAnalyzer::clearAllAnalyzingData()
+void LexicalAnalyzer::addError(const Diagnostic &error)
 {
-    m_errorText.clear();
-    m_tokenList.clear();
+    m_diagnostics.append(error);
 }
 
-Token LexicalAnalyzer::getNumberLiteralTokenWithCorrectLength(const QString &lexeme, Expression::Type type)
+void LexicalAnalyzer::clearAllAnalyzingData()
 {
-    if (lexeme.length() > m_maxNumberLiteralLenght) {
-        return Token(lexeme, Token::NONE_CATEGORY, QString("Number literal lenght greater than %1 characters.").arg(m_maxNumberLiteralLenght));
-    } else {
-        return Token(lexeme, Token::NUMBER_LITERAL_CATEGORY, "", QPoint(), type);
-    }
+    m_changedTokenIndex = 0;
+    m_removedTokenCount = m_tokenStream.size();
+    m_addedTokenCount = 0;
+    m_diagnostics.clear();
+    m_isDiagnosticsUpdated = true;
+    m_incorrectTokenCount = 0;
+    m_tokenStream.clear();
+    m_stringPool.clear();
 }
 
 QRegExp LexicalAnalyzer::identifierRegExp() const
@@ -46,6 +56,7 @@ QRegExp LexicalAnalyzer::identifierRegExp() const
 void LexicalAnalyzer::setIdentifierRegExp(const QRegExp &identifierRegExp)
 {
     m_identifierRegExp = identifierRegExp;
+    m_isTransitionTableCompiled = false;
 }
 
 QRegExp LexicalAnalyzer::spaceRegExp() const
@@ -56,6 +67,7 @@ QRegExp LexicalAnalyzer::spaceRegExp() const
 void LexicalAnalyzer::setSpaceRegExp(const QRegExp &spaceRegExp)
 {
     m_spaceRegExp = spaceRegExp;
+    m_isTransitionTableCompiled = false;
 }
 
 QString LexicalAnalyzer::beginStringLiteral() const
@@ -66,38 +78,107 @@ QString LexicalAnalyzer::beginStringLiteral() const
 void LexicalAnalyzer::setBeginStringLiteral(const QString &beginStringLiteral)
 {
     m_beginStringLiteral = beginStringLiteral;
+    m_isTransitionTableCompiled = false;
 }
 
-Token LexicalAnalyzer::getNextToken(const QPoint currentPosition, const QString &sourceString)
+Token LexicalAnalyzer::getNextToken(const QString &sourceCode, int &index, const QPoint &currentPosition) const
 {
-    if (sourceString == "\n")
-        return Token("linefeed", Token::LINE_FEED_CATEGORY, "", currentPosition);
+    const int tokenBeginIndex = index;
+    Expression::Type type = Expression::NONE_TYPE;
+    int terminalId = TerminalIdTable::UNKNOWN_TERMINAL;
+    Token::LexicalError error = Token::UNKNOWN_STRING_ERROR;
+    Token::TokenCategory category = this->scanToken(Utf16SourceText(sourceCode), index, type, terminalId, error);
+
+    if (category == Token::NONE_CATEGORY) {
+        return Token(sourceCode, tokenBeginIndex, index - tokenBeginIndex, Token::NONE_CATEGORY,
+                     ErrorGenerator::lexicalErrorInformation(error,
+                                                             m_maxNumberLiteralLenght,
+                                                             m_maxStringLiteralLenght,
+                                                             m_maxIdentifierNameLenght,
+                                                             m_beginStringLiteral),
+                     currentPosition);
+    }
 
-    QString firstChar = sourceString.mid(0, 1);
-    Token nextToken;
-    if (firstChar.contains(m_spaceRegExp)) {
-        nextToken = this->getSpaceToken(sourceString);
-    } else if (firstChar.contains(QRegExp("[0-9\\.]"))) {
-        nextToken = this->getNumberLiteralToken(sourceString);
-    } else if (firstChar.contains(QRegExp("[A-Za-z_]"))) {
-        nextToken = this->getKeywordToken(sourceString);
-        if (!nextToken.isCorrect()) {
-            nextToken = this->getIdentifierToken(sourceString);
+    if (category == Token::LINE_FEED_CATEGORY) {
+        static const QString lineFeedLexeme("linefeed");
+        return Token(lineFeedLexeme, Token::LINE_FEED_CATEGORY, "", currentPosition);
+    }
+
+    return Token(sourceCode,
+                 tokenBeginIndex,
+                 index - tokenBeginIndex,
+                 category,
+                 "",
+                 currentPosition,
+                 type);
+}
+
+template <typename SourceText>
+Token::TokenCategory LexicalAnalyzer::scanToken(const SourceText &sourceText, int &index, Expression::Type &type, int &terminalId, Token::LexicalError &error) const
+{
+    const int sourceLength = sourceText.length();
+    const int tokenBeginIndex = index;
+
+    int state = LexicalTransitionTable::START_STATE;
+    int tokenEndIndex = tokenBeginIndex;
+    int longestMatchState = LexicalTransitionTable::DEAD_STATE;
+    int longestMatchEndIndex = tokenBeginIndex;
+    int characterLength = 1;
+    while (tokenEndIndex < sourceLength) {
+        int nextState = m_transitionTable.nextState(state, sourceText.characterClass(m_transitionTable, tokenEndIndex, characterLength));
+        if (nextState == LexicalTransitionTable::DEAD_STATE)
+            break;
+        state = nextState;
+        tokenEndIndex += characterLength;
+        if (m_transitionTable.hasStateFlag(state, LexicalTransitionTable::CHARACTER_RUN_FLAG))
+            tokenEndIndex = sourceText.characterRunEnd(m_transitionTable.characterRun(state), tokenEndIndex);
+        if (m_transitionTable.hasStateFlag(state, LexicalTransitionTable::LONGEST_MATCH_FLAG)) {
+            longestMatchState = state;
+            longestMatchEndIndex = tokenEndIndex;
         }
-    } else if (sourceString.indexOf(m_beginStringLiteral) == 0) {
-        nextToken =  this->getStringLiteralToken(sourceString);
-    } else {
-        nextToken = this->getCharacterToken(sourceString);
     }
 
-    nextToken.setPosition(currentPosition);
+    // Reason of incorrect token is given by state where scanning stopped (e.g. "12E" stops after "E")
+    error = m_transitionTable.stateError(state);
+    if (m_transitionTable.stateCategory(state) == Token::NONE_CATEGORY) {
+        // e.g. "<-" when "<" and "<--" are character tokens
+        state = longestMatchState;
+        tokenEndIndex = longestMatchEndIndex;
+    } else if (m_transitionTable.hasStateFlag(state, LexicalTransitionTable::TOKEN_END_FLAG)
+               && (tokenEndIndex < sourceLength)
+               && !m_transitionTable.isTokenEndClass(sourceText.characterClass(m_transitionTable, tokenEndIndex, characterLength))) {
+        // e.g. "123ABC"
+        state = LexicalTransitionTable::DEAD_STATE;
+    }
+
+    Token::TokenCategory category = m_transitionTable.stateCategory(state);
+    type = m_transitionTable.stateType(state);
+    terminalId = m_stateTerminalIds[state];
+    if (m_transitionTable.hasStateFlag(state, LexicalTransitionTable::KEYWORD_FLAG)) {
+        int keywordIndex = sourceText.keywordIndex(m_keywordPerfectHash, tokenBeginIndex, tokenEndIndex - tokenBeginIndex);
+        if (keywordIndex >= 0) {
+            category = Token::KEYWORD_CATEGORY;
+            type = m_keywordTypes[keywordIndex];
+            terminalId = m_keywordTerminalIds[keywordIndex];
+        }
+    }
+    // Lexeme length is counted in characters of QString
+    if (this->isLexemeTooLong(category, tokenEndIndex - tokenBeginIndex)
+            && this->isLexemeTooLong(category, sourceText.utf16Length(tokenBeginIndex, tokenEndIndex - tokenBeginIndex))) {
+        error = GetTooLongLexemeError(category);
+        category = Token::NONE_CATEGORY;
+    }
 
-    if (!nextToken.isCorrect()) {
-        QString wrongLexema = sourceString.mid(0, sourceString.indexOf(m_possibleTokenEndRegExp, 1));
-        nextToken = Token(wrongLexema, Token::NONE_CATEGORY, "Unknown string", currentPosition);
-        this->addError(ErrorGenerator::lexicalError(nextToken));
+    if (category == Token::NONE_CATEGORY) {
+        index = this->findPossibleTokenEnd(sourceText, sourceText.nextCharacterIndex(tokenBeginIndex));
+        type = Expression::NONE_TYPE;
+        terminalId = TerminalIdTable::UNKNOWN_TERMINAL;
+        return Token::NONE_CATEGORY;
     }
-    return nextToken;
+
+    index = tokenEndIndex;
+    error = Token::UNKNOWN_STRING_ERROR;
+    return category;
 }
 
 int LexicalAnalyzer::maxIdentifierNameLenght() const
@@ -113,15 +194,79 @@ void LexicalAnalyzer::setMaxIdentifierNameLenght(int maxIdentifierNameLenght)
 void LexicalAnalyzer::addKeyword(const QString &keyword)
 {
     m_keyWordsHash.insert(keyword,m_keyWordsHash.size());
+    m_isTransitionTableCompiled = false;
 }
 
 void LexicalAnalyzer::addCharacterToken(const QString &characterToken)
 {
-    AddPossibleVariantToRegExpPattern(m_possibleTokenEndRegExp, characterToken.mid(0,1));
+    m_characterTokensHash.insert(characterToken, m_characterTokensHash.size());
+    m_isTransitionTableCompiled = false;
+}
+
+void LexicalAnalyzer::compileTransitionTable()
+{
+    m_transitionTable.clear();
+
+    int lineFeedState = m_transitionTable.addState(Token::LINE_FEED_CATEGORY);
+    m_transitionTable.setTransition(LexicalTransitionTable::START_STATE, '\n', lineFeedState);
+    m_transitionTable.setTokenEndColumn('\n');
+
+    // First space is checked by space regexp, next spaces are ' ' and '\t'
+    int spaceState = m_transitionTable.addState(Token::SPACE_CATEGORY);
+    m_transitionTable.setTransition(spaceState, ' ', spaceState);
+    m_transitionTable.setTransition(spaceState, '\t', spaceState);
+    m_transitionTable.setTokenEndColumn(' ');
+    m_transitionTable.setTokenEndColumn('\t');
+    if (!m_spaceRegExp.isEmpty()) {
+        for (int column = 0; column < LexicalTransitionTable::COLUMN_COUNT; column++) {
+            if (QString(LexicalTransitionTable::GetColumnRepresentative(column)).contains(m_spaceRegExp))
+                m_transitionTable.addTransition(LexicalTransitionTable::START_STATE, column, spaceState);
+        }
+    }
 
-    if (characterToken.length() > m_maxCharacterTokensLenght)
-        m_maxCharacterTokensLenght = characterToken.length();
-    m_characterTokensHash.insert(characterToken, m_keyWordsHash.size());
+    // Order of adding is priority of first character: numbers, words, string literals, character tokens
+    this->addNumberLiteralStates();
+    this->addWordStates();
+    this->addStringLiteralStates();
+    this->addCharacterTokenStates();
+
+    m_transitionTable.compile();
+    this->updateTerminalIds();
+    m_isTransitionTableCompiled = true;
+}
+
+void LexicalAnalyzer::setTerminalIdTable(const TerminalIdTable &terminalIdTable)
+{
+    m_terminalIdTable = terminalIdTable;
+    m_isTransitionTableCompiled = false;
+}
+
+const TerminalIdTable &LexicalAnalyzer::terminalIdTable() const
+{
+    return m_terminalIdTable;
+}
+
+void LexicalAnalyzer::updateTerminalIds()
+{
+    m_stateTerminalIds.fill(TerminalIdTable::UNKNOWN_TERMINAL, m_transitionTable.stateCount());
+    for (int state = 0; state < m_transitionTable.stateCount(); state++) {
+        Token::TokenCategory category = m_transitionTable.stateCategory(state);
+        if (TerminalIdTable::IsCategoryTerminal(category))
+            m_stateTerminalIds[state] = m_terminalIdTable.terminalId(category, QString());
+    }
+
+    // Character token ends in state which is reached by its characters
+    foreach (QString characterToken, m_characterTokensHash.keys()) {
+        int state = LexicalTransitionTable::START_STATE;
+        for (int i = 0; (i < characterToken.length()) && (state != LexicalTransitionTable::DEAD_STATE); i++)
+            state = m_transitionTable.nextState(state, m_transitionTable.characterClass(characterToken.at(i)));
+        if (m_transitionTable.stateCategory(state) == Token::CHAR_TOKEN_CATEGORY)
+            m_stateTerminalIds[state] = m_terminalIdTable.terminalId(Token::CHAR_TOKEN_CATEGORY, characterToken);
+    }
+
+    m_keywordTerminalIds.fill(TerminalIdTable::UNKNOWN_TERMINAL, m_keywordPerfectHash.size());
+    for (int i = 0; i < m_keywordPerfectHash.size(); i++)
+        m_keywordTerminalIds[i] = m_terminalIdTable.terminalId(Token::KEYWORD_CATEGORY, m_keywordPerfectHash.key(i));
 }
 
 int LexicalAnalyzer::maxStringLiteralLenght() const
@@ -144,180 +289,510 @@ void LexicalAnalyzer::setMaxNumberLiteralLenght(int maxNumberLiteralLenght)
     m_maxNumberLiteralLenght = maxNumberLiteralLenght;
 }
 
-Token LexicalAnalyzer::getSpaceToken(const QString &sourceString)
+QList<Token> LexicalAnalyzer::getTokenListWithoutSpaces() const
 {
-    QString lexema = sourceString.mid(0, sourceString.indexOf(QRegExp("[^ \t]")));
-    return Token(lexema,Token::SPACE_CATEGORY);
+    return m_tokenStream.toList();
 }
 
-QList<Token> LexicalAnalyzer::getTokenListWithoutSpaces() const
+bool LexicalAnalyzer::isTransitionTableCompiled() const
 {
-    QList <Token> listWithoutSpaces;
-    foreach (Token currentToken, m_tokenList) {
-        if (currentToken.category() != Token::SPACE_CATEGORY)
-            listWithoutSpaces << currentToken;
-    }
-    return listWithoutSpaces;
+    return m_isTransitionTableCompiled;
+}
+
+void LexicalAnalyzer::setCompiledTransitionTable(const LexicalTransitionTable &transitionTable,
+                                                 const PerfectHash &keywordPerfectHash,
+                                                 const QVector<Expression::Type> &keywordTypes,
+                                                 const QVector<int> &keywordTerminalIds,
+                                                 const QVector<int> &stateTerminalIds)
+{
+    Q_ASSERT(keywordTypes.size() == keywordPerfectHash.size());
+    Q_ASSERT(keywordTerminalIds.size() == keywordPerfectHash.size());
+    Q_ASSERT(stateTerminalIds.size() == transitionTable.stateCount());
+
+    m_transitionTable = transitionTable;
+    m_keywordPerfectHash = keywordPerfectHash;
+    m_keywordTypes = keywordTypes;
+    m_keywordTerminalIds = keywordTerminalIds;
+    m_stateTerminalIds = stateTerminalIds;
+    m_isTransitionTableCompiled = true;
+}
+
+const LexicalTransitionTable &LexicalAnalyzer::transitionTable() const
+{
+    return m_transitionTable;
+}
+
+const PerfectHash &LexicalAnalyzer::keywordPerfectHash() const
+{
+    return m_keywordPerfectHash;
+}
+
+const QVector<Expression::Type> &LexicalAnalyzer::keywordTypes() const
+{
+    return m_keywordTypes;
+}
+
+const QVector<int> &LexicalAnalyzer::keywordTerminalIds() const
+{
+    return m_keywordTerminalIds;
+}
+
+const QVector<int> &LexicalAnalyzer::stateTerminalIds() const
+{
+    return m_stateTerminalIds;
 }
 
 QList<Token> LexicalAnalyzer::tokenList() const
 {
-    return m_tokenList;
+    return m_tokenStream.toList();
+}
+
+TokenStream LexicalAnalyzer::tokenStream() const
+{
+    return m_tokenStream;
+}
+
+const StringPool &LexicalAnalyzer::stringPool() const
+{
+    return m_stringPool;
 }
 
 QString LexicalAnalyzer::errorText() const
 {
-    return m_errorText;
+    return this->diagnostics().text();
+}
+
+const DiagnosticList &LexicalAnalyzer::diagnostics() const
+{
+    if (!m_isDiagnosticsUpdated)
+        this->updateErrorText();
+    return m_diagnostics;
+}
+
+bool LexicalAnalyzer::hasErrors() const
+{
+    // Errors list is empty until it is made, except error of file opening
+    return (m_incorrectTokenCount > 0) || !m_diagnostics.isEmpty();
 }
 
 void LexicalAnalyzer::analyze(const QString &sourceCode)
+{
+    this->analyzeSourceText(Utf16SourceText(sourceCode));
+}
+
+bool LexicalAnalyzer::analyzeFile(const QString &fileName)
+{
+    Utf8SourceCode sourceCode;
+    if (!sourceCode.load(fileName)) {
+        this->clearAllAnalyzingData();
+        this->addError(ErrorGenerator::fileOpenError(fileName));
+        return false;
+    }
+    this->analyzeSourceText(Utf8SourceText(sourceCode));
+    return true;
+}
+
+template <typename SourceText>
+void LexicalAnalyzer::analyzeSourceText(const SourceText &sourceText)
 {
     this->clearAllAnalyzingData();
-    QStringList plainTextList = sourceCode.split("\n");
-    for ( int i = 0; i < plainTextList.count() - 1; i++) {
-        plainTextList[i] += "\n";
+    if (!m_isTransitionTableCompiled)
+        this->compileTransitionTable();
+
+    QList<SourceCodeChunk> chunkList = this->splitIntoChunks(sourceText);
+    if (chunkList.size() > 1)
+        QtConcurrent::blockingMap(chunkList, ChunkAnalyzer<SourceText>(this, sourceText));
+    else
+        this->analyzeChunk(sourceText, chunkList.first());
+
+    m_stringPool = chunkList.first().stringPool;
+    m_tokenStream = chunkList.first().tokenStream;
+    for (int i = 1; i < chunkList.size(); i++) {
+        this->internChunkLexemes(chunkList[i]);
+        m_tokenStream.append(chunkList.at(i).tokenStream);
     }
-    for (int lineIndex = 0; lineIndex < plainTextList.count(); lineIndex ++)
-        this->analyzeLine(plainTextList[lineIndex], lineIndex);
-}
-
-Token LexicalAnalyzer::getNumberLiteralToken(const QString &sourceString)
-{
-    int state = 0;
-    int tokenEndIndex = -1;
-    QString currentChar;
-    for (;;) {
-        tokenEndIndex++;
-        int possibleLexemeEndIndex = sourceString.indexOf(m_possibleTokenEndRegExp, tokenEndIndex);
-        QString possibleLexeme = sourceString.mid(0, possibleLexemeEndIndex);
-        switch (state) {
-        case 0: { //  0124
-            currentChar = sourceString.mid(tokenEndIndex,1);
-            if (currentChar.contains(QRegExp("[0-9]"))) {
-                state = 0;
-            } else if (currentChar.contains(".")) {
-                state = 1;
-            } else if (currentChar.contains("E")) {
-                state = 3;
-            } else if (currentChar.contains(m_possibleTokenEndRegExp)||currentChar.isEmpty()) {
-                return this->getNumberLiteralTokenWithCorrectLength(possibleLexeme, Expression::INTEGER_TYPE);
-            } else {
-                return Token(possibleLexeme, Token::NONE_CATEGORY, "Wrong number literal. After digits might be \".\" or \"E\".");
-            }
-            break;
-        }
-        case 1: { //  01234.
-            currentChar = sourceString.mid(tokenEndIndex, 1);
-            if (currentChar.contains(QRegExp("[0-9]"))) {
-                state = 2;
-            } else if (currentChar.contains(m_possibleTokenEndRegExp)||currentChar.isEmpty()) {
-                return this->getNumberLiteralTokenWithCorrectLength(possibleLexeme, Expression::DOUBLE_TYPE);
-            } else {
-                return Token(possibleLexeme, Token::NONE_CATEGORY, "Wrong number literal. After \".\" must be digit!");
-            }
-            break;
-        }
-        case 2: { //  01234.567
-            currentChar = sourceString.mid(tokenEndIndex,1);
-            if (currentChar.contains(QRegExp("[0-9]"))) {
-                state = 2;
-            } else if (currentChar.contains("E")) {
-                state = 3;
-            } else if (currentChar.contains(m_possibleTokenEndRegExp)||currentChar.isEmpty()) {
-                return this->getNumberLiteralTokenWithCorrectLength(possibleLexeme, Expression::DOUBLE_TYPE);
-            } else {
-                return Token(possibleLexeme, Token::NONE_CATEGORY, "Wrong number literal.");
-            }
-            break;
-        }
-        case 3: { //  01234.567E
-            currentChar = sourceString.mid(tokenEndIndex,1);
-            if (currentChar.contains(QRegExp("[0-9]"))) {
-                state = 5;
-            } else if (currentChar.contains(QRegExp("[\\+\\-]"))) {
-                state = 4;
-            } else {
-                return Token(possibleLexeme, Token::NONE_CATEGORY, "Wrong number literal. After \"E\" might be \"+\", \"-\" or digit.");
-            }
-            break;
+    for (int i = 0; i < chunkList.size(); i++)
+        m_incorrectTokenCount += chunkList.at(i).incorrectTokenCount;
+    m_tokenStream.setTerminalIdTable(m_terminalIdTable);
+    m_tokenStream.setLexicalErrorSettings(m_maxNumberLiteralLenght, m_maxStringLiteralLenght, m_maxIdentifierNameLenght, m_beginStringLiteral);
+    m_addedTokenCount = m_tokenStream.size();
+    m_isDiagnosticsUpdated = (m_incorrectTokenCount == 0);
+}
+
+void LexicalAnalyzer::reanalyze(const QString &sourceCode, int position, int charsRemoved, int charsAdded)
+{
+    if (!m_isTransitionTableCompiled
+            || m_tokenStream.isUtf8SourceCode()
+            || (position < 0)
+            || (charsRemoved < 0)
+            || (charsAdded < 0)
+            || (position + charsRemoved > m_tokenStream.sourceCode().length())
+            || (charsRemoved == m_tokenStream.sourceCode().length())
+            || (m_tokenStream.sourceCode().length() - charsRemoved + charsAdded != sourceCode.length())) {
+        this->analyze(sourceCode);
+        return;
+    }
+
+    // Lines which contain changed characters are analyzed again, token can't be longer than line
+    const QString oldSourceCode = m_tokenStream.sourceCode();
+    int firstLine = m_tokenStream.lineNumberAt(position);
+    int lastLine = m_tokenStream.lineNumberAt(position + charsRemoved);
+    bool isLastLineChanged = (lastLine == m_tokenStream.lineCount() - 1);
+    int oldEndIndex = isLastLineChanged ? oldSourceCode.length() : m_tokenStream.lineBeginIndex(lastLine + 1);
+
+    SourceCodeChunk chunk;
+    chunk.beginIndex = m_tokenStream.lineBeginIndex(firstLine);
+    chunk.endIndex = oldEndIndex + charsAdded - charsRemoved;
+    this->analyzeChunk(Utf16SourceText(sourceCode), chunk);
+    this->internChunkLexemes(chunk);
+    m_changedTokenIndex = m_tokenStream.tokenIndexAt(chunk.beginIndex);
+    m_removedTokenCount = m_tokenStream.tokenIndexAt(oldEndIndex) - m_changedTokenIndex;
+    m_addedTokenCount = chunk.tokenStream.size();
+    m_incorrectTokenCount += chunk.incorrectTokenCount
+            - this->countIncorrectTokens(m_changedTokenIndex, m_changedTokenIndex + m_removedTokenCount);
+    m_tokenStream.replace(chunk.beginIndex, oldEndIndex, chunk.tokenStream, sourceCode);
+    m_tokenStream.setLexicalErrorSettings(m_maxNumberLiteralLenght, m_maxStringLiteralLenght, m_maxIdentifierNameLenght, m_beginStringLiteral);
+
+    // Errors list is made when it is requested, so tokens after change are not checked again
+    m_diagnostics.clear();
+    m_isDiagnosticsUpdated = (m_incorrectTokenCount == 0);
+}
+
+void LexicalAnalyzer::reanalyze(int position, int charsRemoved, const QString &addedText)
+{
+    QString sourceCode = m_tokenStream.sourceCode();
+    position = qBound(0, position, sourceCode.length());
+    charsRemoved = qBound(0, charsRemoved, sourceCode.length() - position);
+    sourceCode.replace(position, charsRemoved, addedText);
+    this->reanalyze(sourceCode, position, charsRemoved, addedText.length());
+}
+
+int LexicalAnalyzer::changedTokenIndex() const
+{
+    return m_changedTokenIndex;
+}
+
+int LexicalAnalyzer::removedTokenCount() const
+{
+    return m_removedTokenCount;
+}
+
+int LexicalAnalyzer::addedTokenCount() const
+{
+    return m_addedTokenCount;
+}
+
+void LexicalAnalyzer::setParallelAnalysisEnabled(bool isEnabled)
+{
+    m_isParallelAnalysisEnabled = isEnabled;
+}
+
+bool LexicalAnalyzer::isParallelAnalysisEnabled() const
+{
+    return m_isParallelAnalysisEnabled;
+}
+
+template <typename SourceText>
+void LexicalAnalyzer::analyzeChunk(const SourceText &sourceText, SourceCodeChunk &chunk) const
+{
+    chunk.tokenStream = sourceText.tokenStream(chunk.beginIndex);
+    chunk.incorrectTokenCount = 0;
+    int index = chunk.beginIndex;
+    while (index < chunk.endIndex) {
+        const int tokenBeginIndex = index;
+        Expression::Type type = Expression::NONE_TYPE;
+        int terminalId = TerminalIdTable::UNKNOWN_TERMINAL;
+        Token::LexicalError error = Token::UNKNOWN_STRING_ERROR;
+        Token::TokenCategory category = this->scanToken(sourceText, index, type, terminalId, error);
+        if (category == Token::SPACE_CATEGORY) {
+            chunk.tokenStream.appendTrivia(tokenBeginIndex, index - tokenBeginIndex);
+            continue;
         }
-        case 4: { //  01234.567E-
-            currentChar = sourceString.mid(tokenEndIndex,1);
-            if (currentChar.contains(QRegExp("[0-9]"))) {
-                state = 5;
-            } else {
-                return Token(possibleLexeme, Token::NONE_CATEGORY, "Wrong number literal. Digits are missing.");
-            }
-            break;
+        int id = -1;
+        if ((category == Token::IDENTIFIER_CATEGORY)
+                || (category == Token::NUMBER_LITERAL_CATEGORY)
+                || (category == Token::STRING_LITERAL_CATEGORY)) {
+            id = sourceText.intern(chunk.stringPool, tokenBeginIndex, index - tokenBeginIndex);
         }
-        case 5: { //  01234.567E-89
-            currentChar = sourceString.mid(tokenEndIndex,1);
-            if (currentChar.contains(QRegExp("[0-9]"))) {
-                state = 5;
-            } else if (currentChar.contains(m_possibleTokenEndRegExp)||currentChar.isEmpty()) {
-                return this->getNumberLiteralTokenWithCorrectLength(possibleLexeme, Expression::DOUBLE_TYPE);
-            } else {
-                return Token(possibleLexeme, Token::NONE_CATEGORY, "Wrong number literal.");
-            }
-            break;
+        NumberLiteral numberLiteral;
+        if (category == Token::NUMBER_LITERAL_CATEGORY)
+            numberLiteral = sourceText.decodeNumberLiteral(tokenBeginIndex, index - tokenBeginIndex, type);
+        chunk.tokenStream.append(category, type, tokenBeginIndex, index - tokenBeginIndex, id, numberLiteral, terminalId, error);
+        if ((category == Token::NONE_CATEGORY) || !numberLiteral.isCorrect())
+            chunk.incorrectTokenCount++;
+    }
+}
+
+void LexicalAnalyzer::internChunkLexemes(SourceCodeChunk &chunk)
+{
+    QVector<int> newIds(chunk.stringPool.size());
+    for (int id = 0; id < chunk.stringPool.size(); id++)
+        newIds[id] = m_stringPool.intern(chunk.stringPool.string(id));
+    chunk.tokenStream.mapIds(newIds);
+}
+
+template <typename SourceText>
+QList<LexicalAnalyzer::SourceCodeChunk> LexicalAnalyzer::splitIntoChunks(const SourceText &sourceText) const
+{
+    const int sourceLength = sourceText.length();
+    int chunkCount = 1;
+    if (m_isParallelAnalysisEnabled)
+        chunkCount = qBound(1, sourceLength / MIN_CHUNK_LENGHT, QThread::idealThreadCount());
+
+    // No token contains line feed, so chunks are cut after line feeds
+    QList<SourceCodeChunk> chunkList;
+    int beginIndex = sourceText.beginIndex();
+    for (int i = 1; i <= chunkCount; i++) {
+        int endIndex = sourceLength;
+        if (i < chunkCount) {
+            endIndex = sourceText.indexOfLineFeed(qMax(beginIndex, int(qint64(sourceLength) * i / chunkCount) - 1));
+            endIndex = (endIndex < 0) ? sourceLength : endIndex + 1;
         }
-        default:
+        SourceCodeChunk chunk;
+        chunk.beginIndex = beginIndex;
+        chunk.endIndex = endIndex;
+        chunkList.append(chunk);
+        beginIndex = endIndex;
+        if (beginIndex == sourceLength)
             break;
+    }
+    return chunkList;
+}
+
+void LexicalAnalyzer::updateErrorText() const
+{
+    m_diagnostics.clear();
+    for (int i = 0; i < m_tokenStream.size(); i++) {
+        if (!m_tokenStream.isCorrect(i)) {
+            m_diagnostics.append(ErrorGenerator::lexicalError(m_tokenStream.token(i)));
         }
+        else if (!m_tokenStream.numberLiteral(i).isCorrect())
+            m_diagnostics.append(ErrorGenerator::numberLiteralError(m_tokenStream.token(i), m_tokenStream.numberLiteral(i)));
     }
+    m_isDiagnosticsUpdated = true;
 }
 
-Token LexicalAnalyzer::getKeywordToken(const QString &sourceString)
+int LexicalAnalyzer::countIncorrectTokens(int beginTokenIndex, int endTokenIndex) const
 {
-    QString lexema = sourceString.mid(0,sourceString.indexOf(QRegExp("\\W")));
-    if (m_keyWordsHash.contains(lexema)) {
-        if (lexema == "TRUE" || lexema == "FALSE") {
-           return Token(lexema, Token::KEYWORD_CATEGORY, "", QPoint(), Expression::BOOLEAN_TYPE);
+    int count = 0;
+    for (int i = beginTokenIndex; i < endTokenIndex; i++) {
+        if (!m_tokenStream.isCorrect(i) || !m_tokenStream.numberLiteral(i).isCorrect())
+            count++;
+    }
+    return count;
+}
+
+template <typename SourceText>
+LexicalAnalyzer::ChunkAnalyzer<SourceText>::ChunkAnalyzer(const LexicalAnalyzer *lexicalAnalyzer, const SourceText &sourceText) :
+    m_lexicalAnalyzer(lexicalAnalyzer),
+    m_sourceText(sourceText)
+{}
+
+template <typename SourceText>
+void LexicalAnalyzer::ChunkAnalyzer<SourceText>::operator()(SourceCodeChunk &chunk) const
+{
+    m_lexicalAnalyzer->analyzeChunk(m_sourceText, chunk);
+}
+
+void LexicalAnalyzer::addNumberLiteralStates()
+{
+    const int startState = LexicalTransitionTable::START_STATE;
+    const int tokenEndFlag = LexicalTransitionTable::TOKEN_END_FLAG;
+
+    //  0124
+    int integerPartState = m_transitionTable.addState(Token::NUMBER_LITERAL_CATEGORY, tokenEndFlag, Expression::INTEGER_TYPE);
+    //  01234.
+    int pointState = m_transitionTable.addState(Token::NUMBER_LITERAL_CATEGORY, tokenEndFlag, Expression::DOUBLE_TYPE);
+    //  01234.567
+    int fractionalPartState = m_transitionTable.addState(Token::NUMBER_LITERAL_CATEGORY, tokenEndFlag, Expression::DOUBLE_TYPE);
+    //  01234.567E
+    int exponentState = m_transitionTable.addState();
+    //  01234.567E-
+    int exponentSignState = m_transitionTable.addState();
+    //  01234.567E-89
+    int exponentPartState = m_transitionTable.addState(Token::NUMBER_LITERAL_CATEGORY, tokenEndFlag, Expression::DOUBLE_TYPE);
+
+    m_transitionTable.setStateError(integerPartState, Token::WRONG_NUMBER_AFTER_DIGITS_ERROR);
+    m_transitionTable.setStateError(pointState, Token::WRONG_NUMBER_AFTER_POINT_ERROR);
+    m_transitionTable.setStateError(fractionalPartState, Token::WRONG_NUMBER_ERROR);
+    m_transitionTable.setStateError(exponentState, Token::WRONG_NUMBER_AFTER_EXPONENT_ERROR);
+    m_transitionTable.setStateError(exponentSignState, Token::MISSING_EXPONENT_DIGITS_ERROR);
+    m_transitionTable.setStateError(exponentPartState, Token::WRONG_NUMBER_ERROR);
+
+    for (char digit = '0'; digit <= '9'; digit++) {
+        m_transitionTable.addTransition(startState, digit, integerPartState);
+        m_transitionTable.setTransition(integerPartState, digit, integerPartState);
+        m_transitionTable.setTransition(pointState, digit, fractionalPartState);
+        m_transitionTable.setTransition(fractionalPartState, digit, fractionalPartState);
+        m_transitionTable.setTransition(exponentState, digit, exponentPartState);
+        m_transitionTable.setTransition(exponentSignState, digit, exponentPartState);
+        m_transitionTable.setTransition(exponentPartState, digit, exponentPartState);
+    }
+    m_transitionTable.addTransition(startState, '.', pointState);
+    m_transitionTable.setTransition(integerPartState, '.', pointState);
+    m_transitionTable.setTransition(integerPartState, 'E', exponentState);
+    m_transitionTable.setTransition(fractionalPartState, 'E', exponentState);
+    m_transitionTable.setTransition(exponentState, '+', exponentSignState);
+    m_transitionTable.setTransition(exponentState, '-', exponentSignState);
+}
+
+void LexicalAnalyzer::addWordStates()
+{
+    const int startState = LexicalTransitionTable::START_STATE;
+    const int columnCount = LexicalTransitionTable::COLUMN_COUNT;
+
+    // Identifier regexp is checked for every first and next character of identifier (e.g. [A-Z_][A-Z0-9_]*)
+    QVector<bool> isWordColumn(columnCount);
+    QVector<bool> isIdentifierBeginColumn(columnCount);
+    QVector<bool> isIdentifierPartColumn(columnCount);
+    QString identifierBegin;
+    for (int column = 0; column < columnCount; column++) {
+        QChar character = LexicalTransitionTable::GetColumnRepresentative(column);
+        isWordColumn[column] = character.isLetterOrNumber() || character.isMark() || (character == '_');
+        isIdentifierBeginColumn[column] = isWordColumn[column] && m_identifierRegExp.exactMatch(QString(character));
+        if (isIdentifierBeginColumn[column] && identifierBegin.isEmpty())
+            identifierBegin = character;
+    }
+    for (int column = 0; column < columnCount; column++) {
+        QChar character = LexicalTransitionTable::GetColumnRepresentative(column);
+        isIdentifierPartColumn[column] = isWordColumn[column]
+                && !identifierBegin.isEmpty()
+                && m_identifierRegExp.exactMatch(identifierBegin + character);
+    }
+
+    int identifierState = m_transitionTable.addState(Token::IDENTIFIER_CATEGORY, LexicalTransitionTable::KEYWORD_FLAG);
+    int wrongWordState = m_transitionTable.addState(Token::NONE_CATEGORY, LexicalTransitionTable::KEYWORD_FLAG);
+    m_transitionTable.setStateError(wrongWordState, Token::WRONG_IDENTIFIER_ERROR);
+
+    for (int column = 0; column < columnCount; column++) {
+        if ((column < 128) && IsWordBeginCharacter(QChar(column)))
+            m_transitionTable.addTransition(startState, column, isIdentifierBeginColumn[column] ? identifierState : wrongWordState);
+        if (!isWordColumn[column])
+            continue;
+        m_transitionTable.setTransition(identifierState, column, isIdentifierPartColumn[column] ? identifierState : wrongWordState);
+        m_transitionTable.setTransition(wrongWordState, column, wrongWordState);
+    }
+
+    // Keyword is recognized only when whole word is keyword
+    QStringList keywords;
+    foreach (QString keyword, m_keyWordsHash.keys()) {
+        if (keyword.isEmpty() || !IsWordBeginCharacter(keyword.at(0)))
+            continue;
+        int firstState = m_transitionTable.transition(startState, keyword.at(0).unicode());
+        if ((firstState != identifierState) && (firstState != wrongWordState))
+            continue;
+        bool isWord = true;
+        for (int i = 0; i < keyword.length(); i++) {
+            int column = LexicalTransitionTable::GetColumn(keyword.at(i));
+            isWord = isWord && (column < 256) && isWordColumn[column];
         }
-        return Token(lexema, Token::KEYWORD_CATEGORY);
-    } else {
-        return Token(lexema, Token::NONE_CATEGORY);
+        if (isWord)
+            keywords.append(keyword);
+    }
+    m_keywordPerfectHash.build(keywords);
+
+    m_keywordTypes.fill(Expression::NONE_TYPE, m_keywordPerfectHash.size());
+    for (int i = 0; i < m_keywordPerfectHash.size(); i++) {
+        QString keyword = m_keywordPerfectHash.key(i);
+        if ((keyword == "TRUE") || (keyword == "FALSE"))
+            m_keywordTypes[i] = Expression::BOOLEAN_TYPE;
     }
 }
 
-Token LexicalAnalyzer::getIdentifierToken(const QString &sourceString)
+void LexicalAnalyzer::addStringLiteralStates()
 {
-    QString lexema = sourceString.mid(0,sourceString.indexOf(QRegExp("\\W")));
-    if (m_identifierRegExp.exactMatch(lexema)) {
-        if (lexema.count() <= m_maxIdentifierNameLenght) {
-            return Token(lexema, Token::IDENTIFIER_CATEGORY);
-        } else {
-            return Token(lexema, Token::NONE_CATEGORY, QString("Identifier lenght greater than %1 characters.").arg(m_maxIdentifierNameLenght));
+    const QString &delimiter = m_beginStringLiteral;
+    if (delimiter.isEmpty())
+        return;
+    for (int i = 0; i < delimiter.length(); i++) {
+        if (delimiter.at(i).unicode() >= 256)
+            return;
+    }
+    if (m_transitionTable.transition(LexicalTransitionTable::START_STATE, delimiter.at(0).unicode()) != LexicalTransitionTable::DEAD_STATE)
+        return;
+
+    // closingStates[i] - state after i characters of closing delimiter, closingStates[0] - inside literal
+    QVector<int> closingStates;
+    for (int i = 0; i < delimiter.length(); i++) {
+        closingStates.append(m_transitionTable.addState());
+        m_transitionTable.setStateError(closingStates.last(), Token::MISSING_STRING_END_ERROR);
+    }
+    closingStates.append(m_transitionTable.addState(Token::STRING_LITERAL_CATEGORY, LexicalTransitionTable::NO_FLAGS, Expression::STRING_TYPE));
+
+    int state = LexicalTransitionTable::START_STATE;
+    for (int i = 0; i < delimiter.length(); i++) {
+        int nextState = (i == delimiter.length() - 1) ? closingStates.first() : m_transitionTable.addState();
+        m_transitionTable.setTransition(state, delimiter.at(i).unicode(), nextState);
+        state = nextState;
+    }
+
+    // String literal can't contain line feed
+    for (int matchedLength = 0; matchedLength < delimiter.length(); matchedLength++) {
+        for (int column = 0; column < LexicalTransitionTable::COLUMN_COUNT; column++) {
+            if (column == '\n')
+                continue;
+            QString text = delimiter.left(matchedLength) + LexicalTransitionTable::GetColumnRepresentative(column);
+            int nextMatchedLength = text.length();
+            while ((nextMatchedLength > 0) && (delimiter.left(nextMatchedLength) != text.right(nextMatchedLength)))
+                nextMatchedLength--;
+            m_transitionTable.setTransition(closingStates[matchedLength], column, closingStates[nextMatchedLength]);
         }
-    } else {
-        return Token(lexema, Token::NONE_CATEGORY, "Wrong identifier");
     }
 }
 
-Token LexicalAnalyzer::getStringLiteralToken(const QString &sourceString)
+void LexicalAnalyzer::addCharacterTokenStates()
 {
-    int lexemaEndIndex = sourceString.indexOf(m_beginStringLiteral,1);
-    if (lexemaEndIndex == -1) {
-        return Token(sourceString, Token::NONE_CATEGORY, "Character " + m_beginStringLiteral +" is missing");
-    } else {
-        QString lexema = sourceString.mid(0,lexemaEndIndex + m_beginStringLiteral.length());
-        if (lexema.length() <= m_maxStringLiteralLenght + (m_beginStringLiteral.length() * 2)) {
-            return Token(lexema, Token::STRING_LITERAL_CATEGORY, "", QPoint(), Expression::STRING_TYPE);
-        } else {
-            return Token(lexema, Token::NONE_CATEGORY, QString("String literal lenght greater than %1 characters.").arg(m_maxStringLiteralLenght));
+    QSet<int> characterTokenStates;
+    foreach (QString characterToken, m_characterTokensHash.keys()) {
+        if (characterToken.isEmpty())
+            continue;
+        m_transitionTable.setTokenEndColumn(LexicalTransitionTable::GetColumn(characterToken.at(0)));
+
+        int state = LexicalTransitionTable::START_STATE;
+        for (int i = 0; (i < characterToken.length()) && (state != LexicalTransitionTable::DEAD_STATE); i++) {
+            int column = characterToken.at(i).unicode();
+            if (column >= 256) {
+                state = LexicalTransitionTable::DEAD_STATE;
+                break;
+            }
+            int nextState = m_transitionTable.transition(state, column);
+            if (nextState == LexicalTransitionTable::DEAD_STATE) {
+                nextState = m_transitionTable.addState();
+                m_transitionTable.setTransition(state, column, nextState);
+                characterTokenStates.insert(nextState);
+            } else if (!characterTokenStates.contains(nextState)) {
+                // First character is used by spaces, numbers, words or string literals
+                nextState = LexicalTransitionTable::DEAD_STATE;
+            }
+            state = nextState;
         }
+        if (state != LexicalTransitionTable::DEAD_STATE)
+            m_transitionTable.setStateToken(state, Token::CHAR_TOKEN_CATEGORY, LexicalTransitionTable::LONGEST_MATCH_FLAG);
     }
 }
 
-Token LexicalAnalyzer::getCharacterToken(const QString &sourceString)
+bool LexicalAnalyzer::isLexemeTooLong(Token::TokenCategory category, int lexemeLength) const
 {
-    QString lexema;
-    for (int i = m_maxIdentifierNameLenght; i > 0; i--) {
-        lexema = sourceString.mid(0,i);
-        if (m_characterTokensHash.contains(lexema))
-            return Token(lexema, Token::CHAR_TOKEN_CATEGORY);
+    switch (category) {
+    case Token::NUMBER_LITERAL_CATEGORY:
+        return lexemeLength > m_maxNumberLiteralLenght;
+    case Token::IDENTIFIER_CATEGORY:
+        return lexemeLength > m_maxIdentifierNameLenght;
+    case Token::STRING_LITERAL_CATEGORY:
+        return lexemeLength > m_maxStringLiteralLenght + (m_beginStringLiteral.length() * 2);
+    default:
+        return false;
     }
-    return Token(lexema, Token::NONE_CATEGORY);
+}
+
+template <typename SourceText>
+int LexicalAnalyzer::findPossibleTokenEnd(const SourceText &sourceText, int index) const
+{
+    const int sourceLength = sourceText.length();
+    int characterLength = 1;
+    while ((index < sourceLength) && !m_transitionTable.isTokenEndClass(sourceText.characterClass(m_transitionTable, index, characterLength)))
+        index += characterLength;
+    return index;
 }
 
 QString MakeStringRepresentation(const QList<Token> &tokenList)
@@ -331,12 +806,8 @@ QString MakeStringRepresentation(const QList<Token> &tokenList)
     return tokenSequenceString;
 }
 
-void AddPossibleVariantToRegExpPattern(QRegExp &oldRegExp, const QString &variant)
+bool IsWordBeginCharacter(QChar character)
 {
-    if (oldRegExp.exactMatch(variant))
-        return;
-    QString oldPattern = oldRegExp.pattern();
-    oldRegExp.setPattern("(" + oldPattern + "|" + "(" + QRegExp::escape(variant) + "))");
-    return;
+    ushort code = character.unicode();
+    return ((code >= 'A') && (code <= 'Z')) || ((code >= 'a') && (code <= 'z')) || (code == '_');
 }
-
@@ -14,6 +14,12 @@
 #include <QRegExp>
 #include <QPoint>
 #include "Token.h"
+#include "TokenStream.h"
+#include "LexicalTransitionTable.h"
+#include "PerfectHash.h"
+#include "StringPool.h"
+#include "TerminalIdTable.h"
+#include "Diagnostic.h"
 
 class Token;
 
@@ -32,8 +38,43 @@ public:
 
     QString errorText() const;
 
+    /*!
+     * This method returns errors of last analysis. After reanalysis list is made again from incorrect tokens
+     * when it is requested first time.
+     *
+     * @return Errors list.
+     */
+    const DiagnosticList &diagnostics() const;
+
+    /*!
+     * This method used to check result of last analysis without making errors list.
+     *
+     * @return If last analysis found errors returns true other returns false.
+     */
+    bool hasErrors() const;
+
+    /*!
+     * This method returns tokens of last analysis as list. Tokens are made from token stream.
+     *
+     * @return List of tokens.
+     */
     QList <Token> tokenList() const;
 
+    /*!
+     * This method returns tokens of last analysis.
+     *
+     * @return Stream of tokens.
+     */
+    TokenStream tokenStream() const;
+
+    /*!
+     * This method returns pool with interned lexemes of identifiers and literals. Ids of token stream are ids
+     * in this pool. Pool is cleared before analysis, after reanalysis it can contain lexemes which were removed.
+     *
+     * @return Pool of lexemes.
+     */
+    const StringPool &stringPool() const;
+
     int maxNumberLiteralLenght() const;
     void setMaxNumberLiteralLenght(int maxNumberLiteralLenght);
 
@@ -53,12 +94,75 @@ public:
     void setIdentifierRegExp(const QRegExp &identifierRegExp);
 
     /*!
-     * This method makes lexical analysis.
+     * This method makes lexical analysis. Tokens share source code and keep it alive.
      *
      * @param[in] sourceCode Source code for lexical analysis.
      */
     void analyze(const QString &sourceCode);
 
+    /*!
+     * This method makes lexical analysis of UTF-8 file. File is mapped to memory and its bytes are scanned
+     * directly, lexemes are decoded only when they are interned or needed by token. Tokens keep mapping alive.
+     * Indexes and columns of tokens are counted in bytes.
+     *
+     * @param[in] fileName Source code file name.
+     * @return If file was opened returns true other returns false and adds error.
+     */
+    bool analyzeFile(const QString &fileName);
+
+    /*!
+     * This method makes lexical analysis after source code change. Only lines which contain changed characters
+     * are analyzed again, new tokens replace tokens of these lines and tokens after change are moved.
+     * If last analyzed source code doesn't match change or is replaced whole source code is analyzed.
+     *
+     * @param[in] sourceCode Source code after change.
+     * @param[in] position Index of first changed character.
+     * @param[in] charsRemoved Count of removed characters.
+     * @param[in] charsAdded Count of added characters.
+     */
+    void reanalyze(const QString &sourceCode, int position, int charsRemoved, int charsAdded);
+
+    /*!
+     * This method makes lexical analysis after change of last analyzed source code. Source code after change
+     * is made from last analyzed source code, so only changed text is passed.
+     *
+     * @param[in] position Index of first changed character.
+     * @param[in] charsRemoved Count of removed characters.
+     * @param[in] addedText Added characters.
+     */
+    void reanalyze(int position, int charsRemoved, const QString &addedText);
+
+    /*!
+     * This method returns index of first token which was replaced by last analysis. After analysis of whole
+     * source code all tokens are replaced. Syntactic analyzer uses replaced tokens to parse only changed part.
+     *
+     * @return Index of token.
+     */
+    int changedTokenIndex() const;
+
+    /*!
+     * This method returns count of replaced tokens before last analysis.
+     *
+     * @return Count of tokens.
+     */
+    int removedTokenCount() const;
+
+    /*!
+     * This method returns count of tokens which replaced old tokens in last analysis.
+     *
+     * @return Count of tokens.
+     */
+    int addedTokenCount() const;
+
+    /*!
+     * This method used to enable lexical analysis of large source code in several threads.
+     * Source code is cut into chunks by line feeds, chunks are analyzed concurrently and merged in order.
+     *
+     * @param[in] isEnabled Is parallel analysis enabled.
+     */
+    void setParallelAnalysisEnabled(bool isEnabled);
+    bool isParallelAnalysisEnabled() const;
+
     /*!
      * This method searches identifier in table by name.
      *
@@ -68,7 +172,8 @@ public:
     int getIdentifierIndex(const QString &identifierName) const;
 
     /*!
-     * This method returns tokens list without space tokens.
+     * This method returns tokens list without space tokens. Spaces are stored in trivia table of token stream,
+     * so list is not filtered.
      *
      * @return Tokens list without space tokens.
      */
@@ -88,95 +193,214 @@ public:
      */
     void addCharacterToken(const QString &characterToken);
 
-protected:
+    /*!
+     * This method used to compile character tokens, literals, spaces and words into transition table
+     * and keywords into perfect hash. It is called after loading settings.
+     * When settings were changed later table is compiled before analysis.
+     */
+    void compileTransitionTable();
+    bool isTransitionTableCompiled() const;
 
     /*!
-     * This method used to get token from source code.
+     * This method used to set tables which were compiled before (e.g. by DialectTableGenerator), so settings
+     * are not compiled. Tables must be compiled from the same settings and terminal id table as analyzer has,
+     * after change of settings table is compiled again before analysis.
      *
-     * @param[in] sourceString Source string.
-     * @return Next token.
+     * @param[in] transitionTable Compiled automaton.
+     * @param[in] keywordPerfectHash Keywords which can be recognized in words.
+     * @param[in] keywordTypes Type of keyword for each index in perfect hash.
+     * @param[in] keywordTerminalIds Terminal id for each index in perfect hash.
+     * @param[in] stateTerminalIds Terminal id of token which ends in each state.
+     */
+    void setCompiledTransitionTable(const LexicalTransitionTable &transitionTable,
+                                    const PerfectHash &keywordPerfectHash,
+                                    const QVector<Expression::Type> &keywordTypes,
+                                    const QVector<int> &keywordTerminalIds,
+                                    const QVector<int> &stateTerminalIds);
+
+    /*!
+     * This method returns compiled automaton. Methods below give compiled tables to dialect table generator.
+     *
+     * @return Automaton.
+     */
+    const LexicalTransitionTable &transitionTable() const;
+    const PerfectHash &keywordPerfectHash() const;
+    const QVector<Expression::Type> &keywordTypes() const;
+    const QVector<int> &keywordTerminalIds() const;
+    const QVector<int> &stateTerminalIds() const;
+
+    /*!
+     * This method used to set terminals of grammar. Every keyword, character token, literal, identifier and
+     * line feed gets terminal id while it is scanned, so syntactic analyzer doesn't compare lexemes.
+     *
+     * @param[in] terminalIdTable Terminal id table of syntactic analyzer.
      */
-    Token getNextToken(const QPoint currentPosition, const QString &sourceString);
+    void setTerminalIdTable(const TerminalIdTable &terminalIdTable);
+    const TerminalIdTable &terminalIdTable() const;
 
     /*!
-     * This method used to get space token from source code.
+     * This method used to get token from source code. Transition table must be compiled.
      *
-     * @param[in] sourceString Source string.
-     * @return Space token.
+     * @param[in] sourceCode Source code.
+     * @param[in,out] index Index of token begin. After call it is index of next token begin.
+     * @param[in] currentPosition Position of token begin.
+     * @return Next token.
      */
-    Token getSpaceToken(const QString &sourceString);
+    Token getNextToken(const QString &sourceCode, int &index, const QPoint &currentPosition) const;
+
+private:
+
+    /*!
+     * @brief This structure used to store part of source code and result of its analysis.
+     */
+    struct SourceCodeChunk {
+        int beginIndex;                     //!< Index of chunk begin in source code.
+        int endIndex;                       //!< Index of chunk end in source code.
+        TokenStream tokenStream;            //!< Tokens of chunk, line numbers are counted from chunk begin.
+        StringPool stringPool;              //!< Lexemes of chunk, ids of tokens are ids in this pool.
+        int incorrectTokenCount;            //!< Count of incorrect tokens and number literals of chunk.
+    };
+
+    /*!
+     * @brief This class used to analyze source code chunks in thread pool.
+     */
+    template <typename SourceText>
+    class ChunkAnalyzer
+    {
+    public:
+        typedef void result_type;
+        ChunkAnalyzer(const LexicalAnalyzer *lexicalAnalyzer, const SourceText &sourceText);
+        void operator()(SourceCodeChunk &chunk) const;
+    private:
+        const LexicalAnalyzer *m_lexicalAnalyzer;
+        const SourceText &m_sourceText;
+    };
 
     /*!
-     * This method used to get number literal token from source code.
+     * This method used to analyze whole source code.
      *
-     * @param[in] sourceString Source string.
-     * @return Number literal token.
+     * @param[in] sourceText Source code (UTF-16 or UTF-8).
      */
-    Token getNumberLiteralToken(const QString &sourceString);
+    template <typename SourceText>
+    void analyzeSourceText(const SourceText &sourceText);
 
     /*!
-     * This method used to get keyword token from source code.
+     * This method used to find end of token in source code. Transition table must be compiled.
      *
-     * @param[in] sourceString Source string.
-     * @return Keyword token.
+     * @param[in] sourceText Source code (UTF-16 or UTF-8).
+     * @param[in,out] index Index of token begin. After call it is index of next token begin.
+     * @param[out] type Token type.
+     * @param[out] terminalId Id of grammar terminal.
+     * @param[out] error Reason of incorrect token.
+     * @return Token category.
      */
-    Token getKeywordToken(const QString &sourceString);
+    template <typename SourceText>
+    Token::TokenCategory scanToken(const SourceText &sourceText, int &index, Expression::Type &type, int &terminalId, Token::LexicalError &error) const;
 
     /*!
-     * This method used to get identifier token from source code.
+     * This method used to analyze part of source code. Chunk must begin at line begin.
      *
-     * @param[in] sourceString Source string.
-     * @return Identifier token.
+     * @param[in] sourceText Source code (UTF-16 or UTF-8).
+     * @param[in,out] chunk Chunk of source code.
      */
-    Token getIdentifierToken(const QString &sourceString);
+    template <typename SourceText>
+    void analyzeChunk(const SourceText &sourceText, SourceCodeChunk &chunk) const;
 
     /*!
-     * This method used to get string literal token from source code.
+     * This method used to move lexemes of analyzed chunk to string pool of analyzer.
      *
-     * @param[in] sourceString Source string.
-     * @return string literal token.
+     * @param[in,out] chunk Analyzed chunk. After call ids of tokens are ids in string pool of analyzer.
      */
-    Token getStringLiteralToken(const QString &sourceString);
+    void internChunkLexemes(SourceCodeChunk &chunk);
 
     /*!
-     * This method used to get character token from source code.
+     * This method used to cut source code into chunks by line feeds.
      *
-     * @param[in] sourceString Source string.
-     * @return Character token.
+     * @param[in] sourceText Source code (UTF-16 or UTF-8).
+     * @return List of chunks.
      */
-    Token getCharacterToken(const QString &sourceString);
+    template <typename SourceText>
+    QList<SourceCodeChunk> splitIntoChunks(const SourceText &sourceText) const;
 
-private:
+    /*!
+     * This method used to make errors list from incorrect tokens and number literals which can't be decoded.
+     */
+    void updateErrorText() const;
 
     /*!
-     * This method used to analyse line of source code.
+     * This method used to count incorrect tokens and number literals which can't be decoded.
      *
-     * @param[in] sourceCodeLine Source code line.
-     * @param[in] lineNumber Line number.
+     * @param[in] beginTokenIndex Index of first token.
+     * @param[in] endTokenIndex Index after last token.
+     * @return Count of tokens.
      */
-    void analyzeLine(const QString &sourceCodeLine, int lineNumber);
+    int countIncorrectTokens(int beginTokenIndex, int endTokenIndex) const;
 
     /*!
      * This method used to add analysis errors.
      *
-     * @param[in] errorString Errors string.
+     * @param[in] error Error information.
      */
-    void addError(const QString &errorString);
+    void addError(const Diagnostic &error);
 
     /*!
      * This method used to clear token list, identifiers list and errors of last analysis.
      */
     void clearAllAnalyzingData();
 
-    Token getNumberLiteralTokenWithCorrectLength(const QString &sourceString, Expression::Type type);
+    /*!
+     * This method used to add states of number literals to transition table.
+     */
+    void addNumberLiteralStates();
+
+    /*!
+     * This method used to add states of words to transition table and build perfect hash of keywords.
+     */
+    void addWordStates();
+
+    /*!
+     * This method used to add states of string literals to transition table.
+     */
+    void addStringLiteralStates();
+
+    /*!
+     * This method used to add states of character tokens to transition table.
+     */
+    void addCharacterTokenStates();
 
-    QList <Token> m_tokenList;                  //!< List of tokens.
-    QString m_errorText;                        //!< Errors string.
+    /*!
+     * This method used to find terminal ids of keywords and of states where tokens end.
+     */
+    void updateTerminalIds();
+
+    /*!
+     * This method used to check is lexeme of token too long.
+     *
+     * @param[in] category Token category.
+     * @param[in] lexemeLength Lexeme lenght.
+     * @return If lexeme lenght greater than maximum for this category returns true other returns false.
+     */
+    bool isLexemeTooLong(Token::TokenCategory category, int lexemeLength) const;
+
+    /*!
+     * This method used to find end of wrong lexeme. (e.g. space, line feed or first character of character token)
+     *
+     * @param[in] sourceText Source code (UTF-16 or UTF-8).
+     * @param[in] index Index of search begin.
+     * @return Index of possible token end or source code lenght.
+     */
+    template <typename SourceText>
+    int findPossibleTokenEnd(const SourceText &sourceText, int index) const;
+
+    TokenStream m_tokenStream;                  //!< Tokens and lines of last analyzed source code.
+    StringPool m_stringPool;                    //!< Interned lexemes of identifiers and literals.
+    mutable DiagnosticList m_diagnostics;       //!< Errors of last analysis.
+    mutable bool m_isDiagnosticsUpdated;        //!< Is errors list made after last analysis.
+    int m_incorrectTokenCount;                  //!< Count of incorrect tokens and number literals.
 
     QHash <QString, int> m_keyWordsHash;        //!< Hash with keywords.
     QHash <QString, int> m_characterTokensHash; //!< Hash with character tokens.
 
-    QRegExp m_possibleTokenEndRegExp;           //!< RegExp that can separate tokens.
     QRegExp m_identifierRegExp;                 //!< RegExp for searching identifiers.
     QRegExp m_spaceRegExp;                      //!< RegExp for searching spaces.
     QString m_beginStringLiteral;               //!< RegExp for searching string literal.
@@ -184,7 +408,20 @@ private:
     int m_maxNumberLiteralLenght;               //!< Maximum number literal lenght.
     int m_maxStringLiteralLenght;               //!< Maximum string literal lenght.
     int m_maxIdentifierNameLenght;              //!< Maximum identifier name lenght.
-    int m_maxCharacterTokensLenght;             //!< Maximum character token lenght.
+
+    LexicalTransitionTable m_transitionTable;   //!< Compiled automaton.
+    PerfectHash m_keywordPerfectHash;           //!< Keywords which can be recognized in words.
+    QVector<Expression::Type> m_keywordTypes;   //!< Type of keyword for each index in perfect hash.
+    bool m_isTransitionTableCompiled;           //!< Is automaton compiled after last settings change.
+    TerminalIdTable m_terminalIdTable;          //!< Terminals of grammar.
+    QVector<int> m_keywordTerminalIds;          //!< Terminal id for each index in perfect hash.
+    QVector<int> m_stateTerminalIds;            //!< Terminal id of token which ends in each state.
+    bool m_isParallelAnalysisEnabled;           //!< Is large source code analyzed in several threads.
+    int m_changedTokenIndex;                    //!< Index of first token replaced by last analysis.
+    int m_removedTokenCount;                    //!< Count of tokens removed by last analysis.
+    int m_addedTokenCount;                      //!< Count of tokens added by last analysis.
+
+    static const int MIN_CHUNK_LENGHT = 65536;  //!< Minimum length of source code chunk for parallel analysis.
 
 };
 
@@ -197,11 +434,11 @@ private:
 QString MakeStringRepresentation(const QList<Token> &tokenList);
 
 /*!
- * This function used to add possible variant to regular expression.
+ * This function used to check can character be first character of keyword or identifier. ([A-Za-z_])
  *
- * @param[in,out] oldRegExp Regular expression.
- * @param[in] string Possible variant.
+ * @param[in] character Character.
+ * @return If character can be first character of word returns true other returns false.
  */
-void AddPossibleVariantToRegExpPattern(QRegExp &oldRegExp, const QString &string);
+bool IsWordBeginCharacter(QChar character);
 
 #endif // LEXICALANALYZER_H
@@ -0,0 +1,179 @@
+#include "LexicalTransitionTable.h"
+#include <QByteArray>
+#include <QHash>
+
+LexicalTransitionTable::LexicalTransitionTable() :
+    m_characterClassCount(0)
+{
+    this->clear();
+}
+
+void LexicalTransitionTable::clear()
+{
+    m_stateCategories.clear();
+    m_stateTypes.clear();
+    m_stateFlags.clear();
+    m_stateErrors.clear();
+    m_columnTransitions.clear();
+    m_tokenEndColumns.fill(false, COLUMN_COUNT);
+
+    m_characterClasses.fill(0, COLUMN_COUNT);
+    m_transitions.clear();
+    m_tokenEndClasses.clear();
+    m_characterClassCount = 0;
+    m_characterRuns.clear();
+
+    this->addState(); // DEAD_STATE
+    this->addState(); // START_STATE
+}
+
+int LexicalTransitionTable::addState(Token::TokenCategory category, int flags, Expression::Type type)
+{
+    m_stateCategories.append(category);
+    m_stateTypes.append(type);
+    m_stateFlags.append(flags);
+    m_stateErrors.append(Token::UNKNOWN_STRING_ERROR);
+    m_columnTransitions.resize(m_columnTransitions.size() + COLUMN_COUNT);
+    return m_stateCategories.size() - 1;
+}
+
+void LexicalTransitionTable::setStateToken(int state, Token::TokenCategory category, int flags, Expression::Type type)
+{
+    m_stateCategories[state] = category;
+    m_stateTypes[state] = type;
+    m_stateFlags[state] = flags;
+}
+
+void LexicalTransitionTable::setStateError(int state, Token::LexicalError error)
+{
+    m_stateErrors[state] = error;
+}
+
+void LexicalTransitionTable::setTransition(int fromState, int column, int toState)
+{
+    m_columnTransitions[fromState * COLUMN_COUNT + column] = toState;
+}
+
+int LexicalTransitionTable::transition(int fromState, int column) const
+{
+    return m_columnTransitions[fromState * COLUMN_COUNT + column];
+}
+
+bool LexicalTransitionTable::addTransition(int fromState, int column, int toState)
+{
+    if (this->transition(fromState, column) != DEAD_STATE)
+        return false;
+    this->setTransition(fromState, column, toState);
+    return true;
+}
+
+void LexicalTransitionTable::setTokenEndColumn(int column)
+{
+    m_tokenEndColumns[column] = true;
+}
+
+void LexicalTransitionTable::compile()
+{
+    Q_ASSERT(this->stateCount() <= 0xFFFF);
+
+    // Columns with the same transitions in every state become one character class
+    QHash<QByteArray, int> classBySignature;
+    QVector<int> classRepresentativeColumns;
+    for (int column = 0; column < COLUMN_COUNT; column++) {
+        QByteArray signature;
+        signature.append(m_tokenEndColumns[column] ? '\1' : '\0');
+        for (int state = 0; state < this->stateCount(); state++) {
+            int toState = this->transition(state, column);
+            signature.append(char(toState & 0xFF));
+            signature.append(char(toState >> 8));
+        }
+        if (!classBySignature.contains(signature)) {
+            classBySignature.insert(signature, classRepresentativeColumns.size());
+            classRepresentativeColumns.append(column);
+        }
+        m_characterClasses[column] = classBySignature.value(signature);
+    }
+
+    m_characterClassCount = classRepresentativeColumns.size();
+    m_transitions.fill(DEAD_STATE, this->stateCount() * m_characterClassCount);
+    m_tokenEndClasses.fill(false, m_characterClassCount);
+    for (int characterClass = 0; characterClass < m_characterClassCount; characterClass++) {
+        int column = classRepresentativeColumns[characterClass];
+        m_tokenEndClasses[characterClass] = m_tokenEndColumns[column];
+        for (int state = 0; state < this->stateCount(); state++) {
+            m_transitions[state * m_characterClassCount + characterClass] = this->transition(state, column);
+        }
+    }
+    m_columnTransitions.clear();
+    this->updateCharacterRuns();
+}
+
+void LexicalTransitionTable::setCompiledTable(const QVector<int> &characterClasses, const QVector<quint16> &transitions, const QVector<bool> &tokenEndClasses)
+{
+    Q_ASSERT(characterClasses.size() == COLUMN_COUNT);
+    Q_ASSERT(transitions.size() == this->stateCount() * tokenEndClasses.size());
+
+    m_characterClasses = characterClasses;
+    m_transitions = transitions;
+    m_tokenEndClasses = tokenEndClasses;
+    m_characterClassCount = tokenEndClasses.size();
+    m_columnTransitions.clear();
+    this->updateCharacterRuns();
+}
+
+void LexicalTransitionTable::updateCharacterRuns()
+{
+    m_characterRuns.fill(CharacterRunScanner(), this->stateCount());
+    for (int state = 0; state < this->stateCount(); state++) {
+        m_stateFlags[state] &= ~CHARACTER_RUN_FLAG;
+        if (this->makeCharacterRun(state, m_characterRuns[state]))
+            m_stateFlags[state] |= CHARACTER_RUN_FLAG;
+    }
+}
+
+bool LexicalTransitionTable::makeCharacterRun(int state, CharacterRunScanner &characterRun) const
+{
+    if (state == DEAD_STATE)
+        return false;
+
+    // Ranges of ASCII characters which don't change state (e.g. [0-9A-Z_] for identifier)
+    CharacterRunScanner scanner;
+    int column = 0;
+    while (column < 0x80) {
+        if (this->nextState(state, m_characterClasses[column]) != state) {
+            column++;
+            continue;
+        }
+        int firstColumn = column;
+        while ((column < 0x80) && (this->nextState(state, m_characterClasses[column]) == state))
+            column++;
+        if (!scanner.addRange(uchar(firstColumn), uchar(column - 1)))
+            return false;
+    }
+    if (scanner.isEmpty())
+        return false;
+    characterRun = scanner;
+    return true;
+}
+
+int LexicalTransitionTable::stateCount() const
+{
+    return m_stateCategories.size();
+}
+
+int LexicalTransitionTable::characterClassCount() const
+{
+    return m_characterClassCount;
+}
+
+QChar LexicalTransitionTable::GetColumnRepresentative(int column)
+{
+    switch (column) {
+    case OTHER_LETTER_COLUMN:
+        return QChar(0x0416); // CYRILLIC CAPITAL LETTER ZHE
+    case OTHER_CHARACTER_COLUMN:
+        return QChar(0x2022); // BULLET
+    default:
+        return QChar(column);
+    }
+}
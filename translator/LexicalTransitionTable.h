@@ -0,0 +1,235 @@
+#ifndef LEXICALTRANSITIONTABLE_H
+#define LEXICALTRANSITIONTABLE_H
+
+#include <QVector>
+#include <QChar>
+#include <QtGlobal>
+#include "Token.h"
+#include "CharacterRunScanner.h"
+
+/*!
+ * @brief This class used to store deterministic finite automaton of lexical analyzer.
+ *
+ * Automaton is built over 258 input columns: 256 Latin-1 characters, one column for all other letters
+ * and digits and one column for all other characters. After building columns with the same behaviour
+ * are merged into character classes, so transitions are stored as one flat [state x class] table.
+ */
+class LexicalTransitionTable
+{
+
+public:
+
+    /*!
+     * @brief This enumerate include special states of automaton.
+     */
+    enum SpecialState {
+        DEAD_STATE  = 0,    //!< There is no transition.
+        START_STATE = 1     //!< Begin of every token.
+    };
+
+    /*!
+     * @brief This enumerate include flags of automaton states.
+     *
+     * State is accepting when its token category is not NONE_CATEGORY.
+     */
+    enum StateFlag {
+        NO_FLAGS            = 0,
+        TOKEN_END_FLAG      = 1,    //!< Token can end in this state only before token end character or source end.
+        LONGEST_MATCH_FLAG  = 2,    //!< Scanning can go back to this state when longer token is wrong.
+        KEYWORD_FLAG        = 4,    //!< Lexeme which ends in this state can be keyword.
+        CHARACTER_RUN_FLAG  = 8     //!< State stays the same on run of ASCII characters. (set by compilation)
+    };
+
+    static const int COLUMN_COUNT = 258;            //!< Count of input columns.
+    static const int OTHER_LETTER_COLUMN = 256;     //!< Column of letters and digits out of Latin-1.
+    static const int OTHER_CHARACTER_COLUMN = 257;  //!< Column of other characters out of Latin-1.
+
+    LexicalTransitionTable();
+
+    /*!
+     * This method used to remove all states except dead and start states.
+     */
+    void clear();
+
+    /*!
+     * This method used to add new state to automaton.
+     *
+     * @param[in] category Category of token which ends in this state.
+     * @param[in] flags State flags.
+     * @param[in] type Type of token which ends in this state.
+     * @return Index of new state.
+     */
+    int addState(Token::TokenCategory category = Token::NONE_CATEGORY, int flags = NO_FLAGS, Expression::Type type = Expression::NONE_TYPE);
+
+    /*!
+     * This method used to change token which ends in state.
+     *
+     * @param[in] state State.
+     * @param[in] category Category of token which ends in this state.
+     * @param[in] flags State flags.
+     * @param[in] type Type of token which ends in this state.
+     */
+    void setStateToken(int state, Token::TokenCategory category, int flags = NO_FLAGS, Expression::Type type = Expression::NONE_TYPE);
+
+    /*!
+     * This method used to set reason of incorrect token which stops in state. (e.g. "12E" stops after "E")
+     * New states have UNKNOWN_STRING_ERROR.
+     *
+     * @param[in] state State.
+     * @param[in] error Reason of incorrect token.
+     */
+    void setStateError(int state, Token::LexicalError error);
+
+    /*!
+     * This method used to add transition to automaton. Transitions can be added only before compilation.
+     *
+     * @param[in] fromState State.
+     * @param[in] column Input column.
+     * @param[in] toState Next state.
+     */
+    void setTransition(int fromState, int column, int toState);
+    int transition(int fromState, int column) const;
+
+    /*!
+     * This method used to add transition only when state has no transition by this column.
+     *
+     * @param[in] fromState State.
+     * @param[in] column Input column.
+     * @param[in] toState Next state.
+     * @return If transition was added returns true other returns false.
+     */
+    bool addTransition(int fromState, int column, int toState);
+
+    /*!
+     * This method used to mark column as token end. (e.g. space, line feed or first character of character token)
+     *
+     * @param[in] column Input column.
+     */
+    void setTokenEndColumn(int column);
+
+    /*!
+     * This method used to merge equal columns into character classes and build flat transition table.
+     * Character run scanners are made for states which have transitions to themselves by ASCII characters.
+     */
+    void compile();
+
+    /*!
+     * This method used to set character classes and transitions which were compiled before (e.g. by
+     * DialectTableGenerator), so columns are not merged again. States must be added before. Character run
+     * scanners are made as by compilation.
+     *
+     * @param[in] characterClasses Character class for each column.
+     * @param[in] transitions Transitions [state x character class].
+     * @param[in] tokenEndClasses Token end flag for each character class.
+     */
+    void setCompiledTable(const QVector<int> &characterClasses, const QVector<quint16> &transitions, const QVector<bool> &tokenEndClasses);
+
+    inline int characterClass(QChar character) const
+    {
+        return m_characterClasses[GetColumn(character)];
+    }
+
+    inline int nextState(int state, int characterClass) const
+    {
+        return m_transitions[state * m_characterClassCount + characterClass];
+    }
+
+    inline bool isTokenEndClass(int characterClass) const
+    {
+        return m_tokenEndClasses[characterClass];
+    }
+
+    inline Token::TokenCategory stateCategory(int state) const
+    {
+        return m_stateCategories[state];
+    }
+
+    inline Expression::Type stateType(int state) const
+    {
+        return m_stateTypes[state];
+    }
+
+    inline Token::LexicalError stateError(int state) const
+    {
+        return Token::LexicalError(m_stateErrors[state]);
+    }
+
+    inline bool hasStateFlag(int state, StateFlag flag) const
+    {
+        return (m_stateFlags[state] & flag) != 0;
+    }
+
+    inline int stateFlags(int state) const
+    {
+        return m_stateFlags[state];
+    }
+
+    /*!
+     * This method returns scanner of characters which don't change state. State must have CHARACTER_RUN_FLAG.
+     *
+     * @param[in] state State.
+     * @return Character run scanner.
+     */
+    inline const CharacterRunScanner &characterRun(int state) const
+    {
+        return m_characterRuns[state];
+    }
+
+    int stateCount() const;
+    int characterClassCount() const;
+
+    /*!
+     * This method returns input column of character.
+     *
+     * @param[in] character Character.
+     * @return Input column.
+     */
+    static inline int GetColumn(QChar character)
+    {
+        ushort code = character.unicode();
+        if (code < 256)
+            return code;
+        return character.isLetterOrNumber() ? OTHER_LETTER_COLUMN : OTHER_CHARACTER_COLUMN;
+    }
+
+    /*!
+     * This method returns character which represents input column.
+     *
+     * @param[in] column Input column.
+     * @return Character.
+     */
+    static QChar GetColumnRepresentative(int column);
+
+private:
+
+    /*!
+     * This method used to make character run scanners of all states after compilation.
+     */
+    void updateCharacterRuns();
+
+    /*!
+     * This method used to make scanner of ASCII characters which don't change state.
+     *
+     * @param[in] state State.
+     * @param[out] characterRun Character run scanner.
+     * @return If state has run which can be scanned returns true other returns false.
+     */
+    bool makeCharacterRun(int state, CharacterRunScanner &characterRun) const;
+
+    QVector<Token::TokenCategory> m_stateCategories;    //!< Category of token for each state.
+    QVector<Expression::Type> m_stateTypes;             //!< Type of token for each state.
+    QVector<int> m_stateFlags;                          //!< Flags for each state.
+    QVector<quint8> m_stateErrors;                      //!< Reason of incorrect token for each state.
+
+    QVector<int> m_columnTransitions;                   //!< Transitions [state x column] before compilation.
+    QVector<bool> m_tokenEndColumns;                    //!< Token end flag for each column.
+
+    QVector<int> m_characterClasses;                    //!< Character class for each column.
+    QVector<quint16> m_transitions;                     //!< Transitions [state x character class].
+    QVector<bool> m_tokenEndClasses;                    //!< Token end flag for each character class.
+    int m_characterClassCount;                          //!< Count of character classes.
+    QVector<CharacterRunScanner> m_characterRuns;       //!< Character run scanner for each state.
+
+};
+
+#endif // LEXICALTRANSITIONTABLE_H
@@ -0,0 +1,181 @@
+#include "NumberLiteral.h"
+#include "PerfectHash.h"
+#include <cstdlib>
+#include <cfloat>
+#include <limits>
+
+static const int MAX_DOUBLE_DIGIT_COUNT = 17;      //!< Significant decimal digits which double can keep.
+static const int MAX_STORED_DIGIT_COUNT = 40;      //!< Significant digits which are passed to strtod.
+static const int MAX_EXPONENT = 100000;            //!< Bigger exponents are cut, result is infinity or zero anyway.
+
+// Powers of ten which are exact in double
+static const double EXACT_POWERS_OF_TEN[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+static const int MAX_EXACT_POWER_OF_TEN = 22;
+
+NumberLiteral::NumberLiteral() :
+    m_integerValue(0),
+    m_type(Expression::NONE_TYPE),
+    m_error(NO_DECODING_ERROR)
+{}
+
+NumberLiteral NumberLiteral::decode(const QChar *lexeme, int length, Expression::Type type)
+{
+    if (type == Expression::INTEGER_TYPE)
+        return NumberLiteral::decodeInteger(lexeme, length);
+    return NumberLiteral::decodeDouble(lexeme, length);
+}
+
+NumberLiteral NumberLiteral::decode(const char *lexeme, int length, Expression::Type type)
+{
+    if (type == Expression::INTEGER_TYPE)
+        return NumberLiteral::decodeInteger(lexeme, length);
+    return NumberLiteral::decodeDouble(lexeme, length);
+}
+
+Expression::Type NumberLiteral::type() const
+{
+    return Expression::Type(m_type);
+}
+
+NumberLiteral::Error NumberLiteral::error() const
+{
+    return Error(m_error);
+}
+
+bool NumberLiteral::isCorrect() const
+{
+    return m_error == NO_DECODING_ERROR;
+}
+
+qint64 NumberLiteral::integerValue() const
+{
+    return (m_type == Expression::INTEGER_TYPE) ? m_integerValue : 0;
+}
+
+double NumberLiteral::doubleValue() const
+{
+    return (m_type == Expression::INTEGER_TYPE) ? double(m_integerValue) : m_doubleValue;
+}
+
+template <typename Char>
+NumberLiteral NumberLiteral::decodeInteger(const Char *lexeme, int length)
+{
+    const qint64 maxValue = std::numeric_limits<qint64>::max();
+
+    NumberLiteral literal;
+    literal.m_type = Expression::INTEGER_TYPE;
+    for (int i = 0; i < length; i++) {
+        const int digit = CharacterCode(lexeme[i]) - '0';
+        if (literal.m_integerValue > (maxValue - digit) / 10) {
+            literal.m_integerValue = maxValue;
+            literal.m_error = OVERFLOW_ERROR;
+            break;
+        }
+        literal.m_integerValue = literal.m_integerValue * 10 + digit;
+    }
+    return literal;
+}
+
+template <typename Char>
+NumberLiteral NumberLiteral::decodeDouble(const Char *lexeme, int length)
+{
+    NumberLiteral literal;
+    literal.m_type = Expression::DOUBLE_TYPE;
+
+    // Value is digits * 10^exponent, leading and trailing zeros are not kept in digits
+    char digits[MAX_STORED_DIGIT_COUNT + 16];
+    int storedDigitCount = 0;
+    int significantDigitCount = 0;
+    int zeroCount = 0;
+    int exponent = 0;
+    bool isFractionalPart = false;
+    int i = 0;
+    for (; i < length; i++) {
+        const ushort character = CharacterCode(lexeme[i]);
+        if (character == '.') {
+            isFractionalPart = true;
+            continue;
+        }
+        if (character == 'E')
+            break;
+        if (isFractionalPart)
+            exponent--;
+        if (character == '0') {
+            if (significantDigitCount > 0)
+                zeroCount++;
+            continue;
+        }
+        for (int j = 0; j <= zeroCount; j++) {
+            if (storedDigitCount < MAX_STORED_DIGIT_COUNT)
+                digits[storedDigitCount++] = (j < zeroCount) ? '0' : char(character);
+            else
+                exponent++;
+            significantDigitCount++;
+        }
+        zeroCount = 0;
+    }
+    exponent += zeroCount;
+
+    if (i < length) {
+        // 01234.567E-89
+        int exponentSign = 1;
+        i++;
+        if ((i < length) && ((CharacterCode(lexeme[i]) == '+') || (CharacterCode(lexeme[i]) == '-'))) {
+            exponentSign = (CharacterCode(lexeme[i]) == '-') ? -1 : 1;
+            i++;
+        }
+        int exponentPart = 0;
+        for (; i < length; i++)
+            exponentPart = qMin(exponentPart * 10 + (CharacterCode(lexeme[i]) - '0'), MAX_EXPONENT);
+        exponent += exponentSign * exponentPart;
+    }
+
+    if (significantDigitCount == 0) {
+        literal.m_doubleValue = 0.0;
+        return literal;
+    }
+
+    quint64 mantissa = 0;
+    if (storedDigitCount <= MAX_DOUBLE_DIGIT_COUNT + 2) {
+        for (int j = 0; j < storedDigitCount; j++)
+            mantissa = mantissa * 10 + (digits[j] - '0');
+    }
+
+    if ((significantDigitCount == storedDigitCount)
+            && (storedDigitCount <= MAX_DOUBLE_DIGIT_COUNT + 2)
+            && (mantissa <= (Q_UINT64_C(1) << 53))
+            && (qAbs(exponent) <= MAX_EXACT_POWER_OF_TEN)) {
+        // Mantissa and power of ten are exact, so one rounding gives correct result
+        if (exponent < 0)
+            literal.m_doubleValue = double(mantissa) / EXACT_POWERS_OF_TEN[-exponent];
+        else
+            literal.m_doubleValue = double(mantissa) * EXACT_POWERS_OF_TEN[exponent];
+    } else {
+        // e.g. "123456789e-30", digits are written without point, so locale is not used
+        int bufferLength = storedDigitCount;
+        digits[bufferLength++] = 'e';
+        if (exponent < 0) {
+            digits[bufferLength++] = '-';
+            exponent = -exponent;
+        }
+        char exponentDigits[16];
+        int exponentDigitCount = 0;
+        do {
+            exponentDigits[exponentDigitCount++] = char('0' + exponent % 10);
+            exponent /= 10;
+        } while (exponent > 0);
+        while (exponentDigitCount > 0)
+            digits[bufferLength++] = exponentDigits[--exponentDigitCount];
+        digits[bufferLength] = '\0';
+        literal.m_doubleValue = std::strtod(digits, NULL);
+    }
+
+    if (qAbs(literal.m_doubleValue) > DBL_MAX)
+        literal.m_error = OVERFLOW_ERROR;
+    else if ((qAbs(literal.m_doubleValue) < DBL_MIN) || (significantDigitCount > MAX_DOUBLE_DIGIT_COUNT))
+        literal.m_error = PRECISION_ERROR;
+    return literal;
+}
@@ -0,0 +1,75 @@
+#ifndef NUMBERLITERAL_H
+#define NUMBERLITERAL_H
+
+#include <QChar>
+#include <QtGlobal>
+#include "Expression.h"
+
+/*!
+ * @brief This class used to store decoded value of number literal.
+ *
+ * Value is decoded once by lexical analyzer, so next stages don't convert lexeme to number again.
+ * Integer literals are decoded to 64-bit integer, other literals are decoded to double.
+ */
+class NumberLiteral
+{
+
+public:
+
+    /*!
+     * @brief This enumerate include errors of number literal decoding.
+     */
+    enum Error {
+        NO_DECODING_ERROR,  //!< Value is decoded.
+        OVERFLOW_ERROR,     //!< Value is too big for its type.
+        PRECISION_ERROR     //!< Value is too small for double or has more significant digits than double.
+    };
+
+    NumberLiteral();
+
+    /*!
+     * This method used to decode lexeme of number literal. No memory is allocated.
+     *
+     * @param[in] lexeme Pointer on first character of lexeme. Lexeme must be accepted by lexical analyzer.
+     * @param[in] length Length of lexeme.
+     * @param[in] type Type of literal (INTEGER_TYPE or DOUBLE_TYPE).
+     * @return Decoded literal.
+     */
+    static NumberLiteral decode(const QChar *lexeme, int length, Expression::Type type);
+    static NumberLiteral decode(const char *lexeme, int length, Expression::Type type);
+
+    Expression::Type type() const;
+    Error error() const;
+    bool isCorrect() const;
+
+    /*!
+     * This method returns value of integer literal.
+     *
+     * @return Value or 0 if literal is not integer.
+     */
+    qint64 integerValue() const;
+
+    /*!
+     * This method returns value of literal as double. Integer literal is converted.
+     *
+     * @return Value.
+     */
+    double doubleValue() const;
+
+private:
+
+    template <typename Char>
+    static NumberLiteral decodeInteger(const Char *lexeme, int length);
+    template <typename Char>
+    static NumberLiteral decodeDouble(const Char *lexeme, int length);
+
+    union {
+        qint64 m_integerValue;          //!< Value of integer literal.
+        double m_doubleValue;           //!< Value of double literal.
+    };
+    quint8 m_type;                      //!< Type of literal.
+    quint8 m_error;                     //!< Error of decoding.
+
+};
+
+#endif // NUMBERLITERAL_H
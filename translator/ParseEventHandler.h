@@ -0,0 +1,45 @@
+#ifndef PARSEEVENTHANDLER_H
+#define PARSEEVENTHANDLER_H
+
+#include "SyntacticSymbol.h"
+#include "Token.h"
+
+/*!
+ * @brief This class used to receive events of syntactic analysis.
+ *
+ * Events are sent while rules are used, so handler can process source code in the same pass without syntax tree.
+ * Every entered rule is exited, rules which were not parsed because of syntax error are exited too.
+ */
+class ParseEventHandler
+{
+
+public:
+
+    virtual ~ParseEventHandler() {}
+
+    /*!
+     * This method is called when rule is used to parse nonterminal.
+     *
+     * @param[in] nonterminal Left part of rule.
+     * @param[in] ruleNumber Number of rule.
+     */
+    virtual void enterRule(const SyntacticSymbol &nonterminal, int ruleNumber) = 0;
+
+    /*!
+     * This method is called when token is parsed as terminal.
+     *
+     * @param[in] token Token.
+     * @param[in] tokenIndex Index of token in order of reading by cursor.
+     */
+    virtual void shiftToken(const Token &token, int tokenIndex) = 0;
+
+    /*!
+     * This method is called when all symbols of rule right part are parsed.
+     *
+     * @param[in] ruleNumber Number of rule.
+     */
+    virtual void exitRule(int ruleNumber) = 0;
+
+};
+
+#endif // PARSEEVENTHANDLER_H
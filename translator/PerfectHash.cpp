@@ -0,0 +1,136 @@
+#include "PerfectHash.h"
+#include <QList>
+
+PerfectHash::PerfectHash()
+{}
+
+void PerfectHash::clear()
+{
+    m_keys.clear();
+    m_seeds.clear();
+}
+
+void PerfectHash::build(const QStringList &keys)
+{
+    this->clear();
+
+    QStringList uniqueKeys;
+    foreach (QString key, keys) {
+        if (!uniqueKeys.contains(key))
+            uniqueKeys.append(key);
+    }
+    const int size = uniqueKeys.size();
+    if (size == 0)
+        return;
+
+    QVector< QList<int> > buckets(size);
+    for (int keyIndex = 0; keyIndex < size; keyIndex++) {
+        const QString &key = uniqueKeys.at(keyIndex);
+        buckets[PerfectHashFunction(key.unicode(), key.length(), 0) % size].append(keyIndex);
+    }
+
+    // Buckets with many strings are placed first while there are a lot of free slots
+    QList<int> bucketOrder;
+    for (int bucket = 0; bucket < size; bucket++) {
+        if (buckets[bucket].size() > 1)
+            bucketOrder.append(bucket);
+    }
+    for (int i = 1; i < bucketOrder.size(); i++) {
+        for (int j = i; (j > 0) && (buckets[bucketOrder[j]].size() > buckets[bucketOrder[j - 1]].size()); j--)
+            bucketOrder.swap(j, j - 1);
+    }
+
+    m_keys.resize(size);
+    m_seeds.fill(0, size);
+    QVector<bool> isSlotUsed(size, false);
+    foreach (int bucket, bucketOrder) {
+        for (quint32 seed = 1; ; seed++) {
+            QList<int> keySlots;
+            foreach (int keyIndex, buckets[bucket]) {
+                const QString &key = uniqueKeys.at(keyIndex);
+                int slot = PerfectHashFunction(key.unicode(), key.length(), seed) % size;
+                if (isSlotUsed[slot] || keySlots.contains(slot))
+                    break;
+                keySlots.append(slot);
+            }
+            if (keySlots.size() != buckets[bucket].size())
+                continue;
+            for (int i = 0; i < keySlots.size(); i++) {
+                isSlotUsed[keySlots[i]] = true;
+                m_keys[keySlots[i]] = uniqueKeys.at(buckets[bucket].at(i));
+            }
+            m_seeds[bucket] = seed;
+            break;
+        }
+    }
+
+    // Buckets with one string take any free slot directly
+    int freeSlot = 0;
+    for (int bucket = 0; bucket < size; bucket++) {
+        if (buckets[bucket].size() != 1)
+            continue;
+        while (isSlotUsed[freeSlot])
+            freeSlot++;
+        isSlotUsed[freeSlot] = true;
+        m_keys[freeSlot] = uniqueKeys.at(buckets[bucket].first());
+        m_seeds[bucket] = -(freeSlot + 1);
+    }
+}
+
+void PerfectHash::setTable(const QVector<QString> &keys, const QVector<int> &seeds)
+{
+    Q_ASSERT(keys.size() == seeds.size());
+    m_keys = keys;
+    m_seeds = seeds;
+}
+
+int PerfectHash::indexOf(const QChar *key, int length) const
+{
+    return this->findKey(key, length);
+}
+
+int PerfectHash::indexOf(const char *key, int length) const
+{
+    return this->findKey(key, length);
+}
+
+template <typename Char>
+int PerfectHash::findKey(const Char *key, int length) const
+{
+    const int size = m_keys.size();
+    if (size == 0)
+        return -1;
+
+    int seed = m_seeds[PerfectHashFunction(key, length, 0) % size];
+    int slot = (seed < 0) ? (-seed - 1) : (PerfectHashFunction(key, length, seed) % size);
+
+    const QString &slotKey = m_keys[slot];
+    if (slotKey.length() != length)
+        return -1;
+    const QChar *slotKeyData = slotKey.unicode();
+    for (int i = 0; i < length; i++) {
+        if (slotKeyData[i].unicode() != CharacterCode(key[i]))
+            return -1;
+    }
+    return slot;
+}
+
+int PerfectHash::indexOf(const QString &key) const
+{
+    return this->indexOf(key.unicode(), key.length());
+}
+
+QString PerfectHash::key(int index) const
+{
+    return m_keys.at(index);
+}
+
+int PerfectHash::seed(int bucket) const
+{
+    return m_seeds.at(bucket);
+}
+
+int PerfectHash::size() const
+{
+    return m_keys.size();
+}
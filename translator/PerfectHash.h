@@ -0,0 +1,101 @@
+#ifndef PERFECTHASH_H
+#define PERFECTHASH_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QChar>
+#include <QtGlobal>
+
+/*!
+ * @brief This class used to store minimal perfect hash of fixed strings set (e.g. keywords).
+ *
+ * Strings are spread over buckets by first hash, then for every bucket seed is chosen so that its strings
+ * get different free slots. Lookup calculates two hashes and compares one string, no memory is allocated.
+ */
+class PerfectHash
+{
+
+public:
+
+    PerfectHash();
+
+    /*!
+     * This method used to build hash of strings set. Repeated strings are added once.
+     *
+     * @param[in] keys Strings set.
+     */
+    void build(const QStringList &keys);
+
+    /*!
+     * This method used to set hash which was built before (e.g. by DialectTableGenerator), so seeds are not
+     * searched again. Strings and seeds are the same as key() and seed() of built hash.
+     *
+     * @param[in] keys Strings by slot.
+     * @param[in] seeds Seed for each bucket.
+     */
+    void setTable(const QVector<QString> &keys, const QVector<int> &seeds);
+
+    void clear();
+
+    /*!
+     * This method used to find string in hash.
+     *
+     * @param[in] key Pointer on first character of string.
+     * @param[in] length Length of string.
+     * @return Index of string (from 0 to size() - 1) or -1 if there is no such string.
+     */
+    int indexOf(const QChar *key, int length) const;
+    int indexOf(const char *key, int length) const;
+    int indexOf(const QString &key) const;
+
+    QString key(int index) const;
+    int seed(int bucket) const;
+    int size() const;
+
+private:
+
+    template <typename Char>
+    int findKey(const Char *key, int length) const;
+
+    QVector<QString> m_keys;    //!< Strings by slot.
+    QVector<int> m_seeds;       //!< Seed for each bucket. Negative seed -(slot + 1) means bucket with one string.
+
+};
+
+/*!
+ * This function returns code of character. Bytes are Latin-1 characters.
+ *
+ * @param[in] character Character.
+ * @return Unicode code of character.
+ */
+inline ushort CharacterCode(QChar character)
+{
+    return character.unicode();
+}
+
+inline ushort CharacterCode(char character)
+{
+    return uchar(character);
+}
+
+/*!
+ * This function used to calculate hash of string. Latin-1 string has the same hash as string of QChar.
+ *
+ * @param[in] key Pointer on first character of string.
+ * @param[in] length Length of string.
+ * @param[in] seed Seed of hash function.
+ * @return Hash of string.
+ */
+template <typename Char>
+inline quint32 PerfectHashFunction(const Char *key, int length, quint32 seed)
+{
+    quint32 hash = 2166136261u ^ (seed * 16777619u);
+    for (int i = 0; i < length; i++) {
+        hash ^= CharacterCode(key[i]);
+        hash *= 16777619u;
+    }
+    return hash ^ (hash >> 15);
+}
+
+#endif // PERFECTHASH_H
@@ -13,87 +13,138 @@ SemanticAnalyzer::~SemanticAnalyzer()
     delete m_mainBlock;
 }
 
-void SemanticAnalyzer::analyze(QList<Token> &tokenList)
+void SemanticAnalyzer::analyze(TokenStream &tokenStream, const SyntaxTree &syntaxTree)
 {
-    if (tokenList.isEmpty()) {
+    if (tokenStream.isEmpty() || syntaxTree.isEmpty()) {
         return;
     }
-    this->prepareToAnalysis(tokenList);
-    this->makeBlocks(tokenList);
-    this->findIdentifiersDeclaration(tokenList);
-    this->checkIdentifiersScope(tokenList);
+    this->prepareToAnalysis(tokenStream);
+    QVector<int> tokenNodes;
+    syntaxTree.appendTokenNodes(syntaxTree.root(), tokenNodes);
+    this->makeBlocks(tokenStream, syntaxTree, tokenNodes);
+    this->findIdentifiersDeclaration(tokenStream, syntaxTree, tokenNodes);
+    this->checkIdentifiersScope(tokenStream);
 }
 
-void SemanticAnalyzer::makeBlocks(const QList<Token> &tokenList)
+void SemanticAnalyzer::makeBlocks(const TokenStream &tokenStream, const SyntaxTree &syntaxTree, const QVector<int> &tokenNodes)
 {
     Block *currentBlock = m_mainBlock;
-    QList<Token>::const_iterator tokenIterator = tokenList.begin();
-    while(tokenIterator != tokenList.end()) {
-        Token currentToken = *tokenIterator;
-        if (currentToken.lexeme() == "FOR") {
-            Block *newChildBlock = new Block(Block::FOR_BLOCK, GetTokenLineNumber(currentToken), currentBlock);
+    foreach (int node, tokenNodes) {
+        const int index = syntaxTree.tokenIndex(node);
+        // Block begins with first terminal of rule, so "IF" of "END IF" is not block begin
+        const bool isRuleBegin = (syntaxTree.childPosition(node) == 0);
+        if (isRuleBegin && tokenStream.lexemeEquals(index, "FOR")) {
+            Block *newChildBlock = new Block(Block::FOR_BLOCK, tokenStream.lineNumber(index), currentBlock);
             currentBlock->addChildBlock(newChildBlock);
             currentBlock = newChildBlock;
-        } else if (currentToken.lexeme() == "IF"){
-            Block *newChildBlock = new Block(Block::IF_BLOCK, GetTokenLineNumber(currentToken), currentBlock);
+        } else if (isRuleBegin && tokenStream.lexemeEquals(index, "IF")){
+            Block *newChildBlock = new Block(Block::IF_BLOCK, tokenStream.lineNumber(index), currentBlock);
             currentBlock->addChildBlock(newChildBlock);
             currentBlock = newChildBlock;
-        } else if ((currentToken.lexeme() == "END")||(currentToken.lexeme() == "NEXT")){
-            currentBlock->setScopeEndLineNumber(GetTokenLineNumber(currentToken));
+        } else if ((tokenStream.lexemeEquals(index, "END"))||(tokenStream.lexemeEquals(index, "NEXT"))){
+            currentBlock->setScopeEndLineNumber(tokenStream.lineNumber(index));
             currentBlock = currentBlock->parent();
-            // jump through <END><space><IF> or <NEXT><space><ID>
-            tokenIterator += 2;
         }
-        tokenIterator++;
     }
 }
 
-void SemanticAnalyzer::findIdentifiersDeclaration(QList<Token> &tokenList)
+/*!
+ * This function used to find identifier and type of declaration "DIM <ID> AS <TYPE>". Nodes after "DIM" are walked
+ * in order of tokens up to end of line, so parts of declaration can be parsed by their own nonterminals
+ * (e.g. <type> ::= "INTEGER"). Walk stops at terminal or nonterminal which was not parsed.
+ *
+ * @param[in] syntaxTree Syntax tree.
+ * @param[in] tokenStream Stream of tokens of tree.
+ * @param[in] declarationNode Index of "DIM" node.
+ * @param[out] identifierIndex Index of identifier token.
+ * @param[out] typeIndex Index of type token.
+ * @return If declaration has identifier, "AS" and known type returns true other returns false.
+ */
+static bool FindDeclarationTokens(const SyntaxTree &syntaxTree,
+                                  const TokenStream &tokenStream,
+                                  int declarationNode,
+                                  int &identifierIndex,
+                                  int &typeIndex)
 {
-    int index = 0;
-    while(index < tokenList.size()) {
-        Token currentToken = tokenList[index];
-        if (currentToken.lexeme() == "DIM") {
-            Block *currentBlock = this->getBlockByLineNumber(GetTokenLineNumber(currentToken));
-            Token *identifierToken = &tokenList[index+2];
-            const Token identifierTypeToken = tokenList[index+6];
-            Identifier *newId = new Identifier(identifierToken->lexeme(),
-                                          StringToType(identifierTypeToken.lexeme()),
-                                          GetTokenLineNumber(currentToken),
-                                          currentBlock->scopeEndLineNumber());
+    const int statementNode = syntaxTree.parent(declarationNode);
+    QVector<int> nodeStack;
+    for (int position = syntaxTree.childCount(statementNode) - 1; position > syntaxTree.childPosition(declarationNode); position--)
+        nodeStack.append(syntaxTree.child(statementNode, position));
+
+    QVector<int> tokenIndexes;
+    while (!nodeStack.isEmpty() && (tokenIndexes.size() < 3)) {
+        const int node = nodeStack.last();
+        nodeStack.removeLast();
+        if (syntaxTree.isToken(node)) {
+            const int index = syntaxTree.tokenIndex(node);
+            if (tokenStream.category(index) == Token::LINE_FEED_CATEGORY)
+                break;
+            tokenIndexes.append(index);
+        } else if (syntaxTree.ruleNumber(node) < 0) {
+            break;
+        } else {
+            for (int position = syntaxTree.childCount(node) - 1; position >= 0; position--)
+                nodeStack.append(syntaxTree.child(node, position));
+        }
+    }
+
+    if ((tokenIndexes.size() < 3)
+            || (tokenStream.category(tokenIndexes.at(0)) != Token::IDENTIFIER_CATEGORY)
+            || !tokenStream.lexemeEquals(tokenIndexes.at(1), "AS")
+            || (StringToType(tokenStream.lexeme(tokenIndexes.at(2))) == Expression::NONE_TYPE)) {
+        return false;
+    }
+    identifierIndex = tokenIndexes.at(0);
+    typeIndex = tokenIndexes.at(2);
+    return true;
+}
+
+void SemanticAnalyzer::findIdentifiersDeclaration(TokenStream &tokenStream, const SyntaxTree &syntaxTree, const QVector<int> &tokenNodes)
+{
+    foreach (int node, tokenNodes) {
+        const int index = syntaxTree.tokenIndex(node);
+        if (tokenStream.lexemeEquals(index, "DIM")) {
+            Block *currentBlock = this->getBlockByLineNumber(tokenStream.lineNumber(index));
+            int identifierIndex = -1;
+            int identifierTypeIndex = -1;
+            if (!FindDeclarationTokens(syntaxTree, tokenStream, node, identifierIndex, identifierTypeIndex)) {
+                this->addError(ErrorGenerator::incorrectDeclaration(tokenStream.token(index)));
+                continue;
+            }
+            Identifier *newId = new Identifier(tokenStream.lexeme(identifierIndex),
+                                          StringToType(tokenStream.lexeme(identifierTypeIndex)),
+                                          tokenStream.lineNumber(index),
+                                          currentBlock->scopeEndLineNumber(),
+                                          tokenStream.id(identifierIndex));
 
             if (currentBlock->isIdentifierDeclared(newId)) {
-                this->addError(ErrorGenerator::redeclarationOfIdentifier(*identifierToken));
+                this->addError(ErrorGenerator::redeclarationOfIdentifier(tokenStream.token(identifierIndex)));
             } else {
                 newId->setCode(m_identifierCount++);
                 currentBlock->addIdentifier(newId);
-                identifierToken->setIdentifier(newId);
+                tokenStream.setType(identifierIndex, newId->type());
             }
         } else {
-            if (currentToken.category() == Token::IDENTIFIER_CATEGORY) {
-                Identifier *id = getIdentifierByToken(currentToken);
+            if (tokenStream.category(index) == Token::IDENTIFIER_CATEGORY) {
+                Identifier *id = getIdentifierByToken(tokenStream, index);
                 if (!id) {
                     return;
                 } else {
-                    tokenList[index].setType(id->type());
+                    tokenStream.setType(index, id->type());
                 }
             }
         }
-        ++index ;
     }
 }
 
-void SemanticAnalyzer::checkIdentifiersScope(const QList<Token> &tokenList)
+void SemanticAnalyzer::checkIdentifiersScope(const TokenStream &tokenStream)
 {
-    QList<Token>::const_iterator tokenIterator = tokenList.begin();
-    while(tokenIterator != tokenList.end()) {
-        Token currentToken = *tokenIterator;
-        if (currentToken.category() == Token::IDENTIFIER_CATEGORY) {
-            if (!isIdentifierDeclarate(currentToken)) {
-                this->addError(ErrorGenerator::undeclaratedIdentifierError(currentToken));
+    for (int index = 0; index < tokenStream.size(); index++) {
+        if (tokenStream.category(index) == Token::IDENTIFIER_CATEGORY) {
+            if (!isIdentifierDeclarate(tokenStream, index)) {
+                this->addError(ErrorGenerator::undeclaratedIdentifierError(tokenStream.token(index)));
             }
         }
-        tokenIterator++;
     }
 }
 
@@ -117,15 +168,16 @@ Block *SemanticAnalyzer::getBlockByLineNumber(const int lineNumber)
     }
 }
 
-bool SemanticAnalyzer::isIdentifierDeclarate(const Token &identifierToken)
+bool SemanticAnalyzer::isIdentifierDeclarate(const TokenStream &tokenStream, int identifierIndex)
 {
-    Block* currentBlock = this->getBlockByLineNumber(GetTokenLineNumber(identifierToken));
+    const int lineNumber = tokenStream.lineNumber(identifierIndex);
+    Block* currentBlock = this->getBlockByLineNumber(lineNumber);
     while (currentBlock) {
         foreach (Identifier *currentIdentifier, currentBlock->identifiers()) {
-            if (currentIdentifier->lexeme() == identifierToken.lexeme()) {
+            if (IsIdentifierToken(currentIdentifier, tokenStream, identifierIndex)) {
                 if (AtRange(currentIdentifier->scopeBeginLineNumber(),
                             currentIdentifier->scopeEndLineNumber(),
-                            GetTokenLineNumber(identifierToken))) {
+                            lineNumber)) {
                     return true;
                 }
             }
@@ -135,35 +187,36 @@ bool SemanticAnalyzer::isIdentifierDeclarate(const Token &identifierToken)
     return false;
 }
 
-void SemanticAnalyzer::addError(QString errorText)
+void SemanticAnalyzer::addError(const Diagnostic &error)
 {
-    m_errorText += QString("%1:\t").arg(m_errorText.split("\n").count()) + errorText + "\n";
+    m_diagnostics.append(error);
 }
 
-void SemanticAnalyzer::prepareToAnalysis(const QList<Token> &tokenList)
+void SemanticAnalyzer::prepareToAnalysis(const TokenStream &tokenStream)
 {
     if (m_mainBlock)
         delete m_mainBlock;
 
     m_mainBlock = new Block();
-    m_mainBlock->setScopeEndLineNumber(tokenList.last().position().y());
-    m_errorText.clear();
+    m_mainBlock->setScopeEndLineNumber(tokenStream.lineNumber(tokenStream.size() - 1));
+    m_diagnostics.clear();
     m_identifierCount = 0;
 }
 
-Identifier *SemanticAnalyzer::getIdentifierByToken(const Token &identifierToken)
+Identifier *SemanticAnalyzer::getIdentifierByToken(const TokenStream &tokenStream, int identifierIndex)
 {
-    if (identifierToken.type() == Expression::NONE_TYPE) {
+    if (tokenStream.type(identifierIndex) == Expression::NONE_TYPE) {
         return NULL;
     }
 
-    Block* currentBlock = this->getBlockByLineNumber(GetTokenLineNumber(identifierToken));
+    const int lineNumber = tokenStream.lineNumber(identifierIndex);
+    Block* currentBlock = this->getBlockByLineNumber(lineNumber);
     while (currentBlock) {
         foreach (Identifier *currentIdentifier, currentBlock->identifiers()) {
-            if (currentIdentifier->lexeme() == identifierToken.lexeme()) {
+            if (IsIdentifierToken(currentIdentifier, tokenStream, identifierIndex)) {
                 if (AtRange(currentIdentifier->scopeBeginLineNumber(),
                             currentIdentifier->scopeEndLineNumber(),
-                            GetTokenLineNumber(identifierToken))) {
+                            lineNumber)) {
                     return currentIdentifier;
                 }
             }
@@ -180,7 +233,12 @@ Block *SemanticAnalyzer::mainBlock() const
 
 QString SemanticAnalyzer::errorText() const
 {
-    return m_errorText;
+    return m_diagnostics.text();
+}
+
+const DiagnosticList &SemanticAnalyzer::diagnostics() const
+{
+    return m_diagnostics;
 }
 
 bool AtRange(int beginRange, int endRange, int value)
@@ -188,3 +246,10 @@ bool AtRange(int beginRange, int endRange, int value)
     return (beginRange <= value)&&(endRange >= value);
 }
 
+bool IsIdentifierToken(const Identifier *identifier, const TokenStream &tokenStream, int index)
+{
+    if ((identifier->lexemeId() >= 0) && (tokenStream.id(index) >= 0))
+        return identifier->lexemeId() == tokenStream.id(index);
+    return tokenStream.lexemeEquals(index, identifier->lexeme());
+}
+
@@ -3,7 +3,10 @@
 
 #include "Block.h"
 #include "Token.h"
+#include "TokenStream.h"
 #include "Identifier.h"
+#include "Diagnostic.h"
+#include "SyntaxTree.h"
 #include <QList>
 
 class SemanticAnalyzer
@@ -13,28 +16,46 @@ public:
 
     SemanticAnalyzer();
     ~SemanticAnalyzer();
-    void analyze (QList<Token> &tokenList);
+    /*!
+     * This method makes semantic analysis. Types of identifiers are set in token stream.
+     *
+     * @param[in,out] tokenStream Stream of tokens.
+     * @param[in] syntaxTree Syntax tree of token stream.
+     */
+    void analyze (TokenStream &tokenStream, const SyntaxTree &syntaxTree);
 
     QString errorText() const;
+    const DiagnosticList &diagnostics() const;
     Block *mainBlock() const;
 
 private:
 
-    void makeBlocks (const QList<Token> &tokenList);
-    void findIdentifiersDeclaration (QList<Token> &tokenList);
-    void checkIdentifiersScope(const QList<Token> &tokenList);
+    void makeBlocks (const TokenStream &tokenStream, const SyntaxTree &syntaxTree, const QVector<int> &tokenNodes);
+    void findIdentifiersDeclaration (TokenStream &tokenStream, const SyntaxTree &syntaxTree, const QVector<int> &tokenNodes);
+    void checkIdentifiersScope(const TokenStream &tokenStream);
     Block *getBlockByLineNumber(const int lineNumber);
-    bool isIdentifierDeclarate(const Token &identifier);
-    void addError(QString errorText);
-    void prepareToAnalysis(const QList<Token> &tokenList);
+    bool isIdentifierDeclarate(const TokenStream &tokenStream, int identifierIndex);
+    void addError(const Diagnostic &error);
+    void prepareToAnalysis(const TokenStream &tokenStream);
 
-    Identifier *getIdentifierByToken(const Token &identifier);
+    Identifier *getIdentifierByToken(const TokenStream &tokenStream, int identifierIndex);
 
     Block *m_mainBlock;
-    QString m_errorText;
+    DiagnosticList m_diagnostics;
     int m_identifierCount;
 };
 
 bool AtRange(int beginRange, int endRange, int value);
 
+/*!
+ * This function used to check is token name of identifier. Interned ids are compared when token and
+ * identifier have them.
+ *
+ * @param[in] identifier Identifier.
+ * @param[in] tokenStream Stream of tokens.
+ * @param[in] index Index of token.
+ * @return If token lexeme is identifier name returns true other returns false.
+ */
+bool IsIdentifierToken(const Identifier *identifier, const TokenStream &tokenStream, int index);
+
 #endif // SEMANTICANALYZER_H
@@ -0,0 +1,276 @@
+#ifndef SOURCETEXT_H
+#define SOURCETEXT_H
+
+#include <QString>
+#include <QChar>
+#include <QtGlobal>
+#include "LexicalTransitionTable.h"
+#include "CharacterRunScanner.h"
+#include "PerfectHash.h"
+#include "StringPool.h"
+#include "NumberLiteral.h"
+#include "TokenStream.h"
+#include "Utf8SourceCode.h"
+
+/*!
+ * @brief This class used by lexical analyzer to scan source code which is stored in QString.
+ *
+ * Lexical analyzer is written once for both source texts, every source text gives character classes,
+ * keywords, interned lexemes and number literals by indexes in its own units.
+ */
+class Utf16SourceText
+{
+
+public:
+
+    explicit Utf16SourceText(const QString &sourceCode) :
+        m_sourceCode(sourceCode),
+        m_data(sourceCode.unicode())
+    {}
+
+    inline int beginIndex() const
+    {
+        return 0;
+    }
+
+    inline int length() const
+    {
+        return m_sourceCode.length();
+    }
+
+    inline int indexOfLineFeed(int from) const
+    {
+        return m_sourceCode.indexOf('\n', from);
+    }
+
+    /*!
+     * This method returns character class of character.
+     *
+     * @param[in] table Transition table.
+     * @param[in] index Index of character.
+     * @param[out] characterLength Count of units of character.
+     * @return Character class.
+     */
+    inline int characterClass(const LexicalTransitionTable &table, int index, int &characterLength) const
+    {
+        characterLength = 1;
+        return table.characterClass(m_data[index]);
+    }
+
+    inline int nextCharacterIndex(int index) const
+    {
+        return index + 1;
+    }
+
+    /*!
+     * This method returns index of first character after run of characters. (e.g. spaces or digits)
+     *
+     * @param[in] characterRun Scanner of characters of run.
+     * @param[in] index Index of first character to check.
+     * @return Index of first character out of run.
+     */
+    inline int characterRunEnd(const CharacterRunScanner &characterRun, int index) const
+    {
+        return characterRun.runEnd(m_data, index, m_sourceCode.length());
+    }
+
+    /*!
+     * This method returns length of lexeme in QString characters. (e.g. to check maximum lexeme length)
+     *
+     * @param[in] index Index of lexeme begin.
+     * @param[in] length Length of lexeme in units.
+     * @return Length of lexeme in characters.
+     */
+    inline int utf16Length(int index, int length) const
+    {
+        Q_UNUSED(index);
+        return length;
+    }
+
+    inline int keywordIndex(const PerfectHash &keywordPerfectHash, int index, int length) const
+    {
+        return keywordPerfectHash.indexOf(m_data + index, length);
+    }
+
+    inline int intern(StringPool &stringPool, int index, int length) const
+    {
+        return stringPool.intern(m_data + index, length);
+    }
+
+    inline NumberLiteral decodeNumberLiteral(int index, int length, Expression::Type type) const
+    {
+        return NumberLiteral::decode(m_data + index, length, type);
+    }
+
+    inline TokenStream tokenStream(int beginIndex) const
+    {
+        return TokenStream(m_sourceCode, beginIndex);
+    }
+
+private:
+
+    const QString &m_sourceCode;    //!< Source code.
+    const QChar *m_data;            //!< Characters of source code.
+
+};
+
+/*!
+ * @brief This class used by lexical analyzer to scan UTF-8 bytes of source code.
+ *
+ * ASCII characters are classified by byte, other characters are decoded only to get their class.
+ * Lexemes are decoded when they aren't ASCII. (e.g. string literals with letters of other languages)
+ */
+class Utf8SourceText
+{
+
+public:
+
+    explicit Utf8SourceText(const Utf8SourceCode &sourceCode) :
+        m_sourceCode(sourceCode),
+        m_data(reinterpret_cast<const uchar *>(sourceCode.data())),
+        m_length(sourceCode.length())
+    {}
+
+    inline int beginIndex() const
+    {
+        return m_sourceCode.beginIndex();
+    }
+
+    inline int length() const
+    {
+        return m_length;
+    }
+
+    inline int indexOfLineFeed(int from) const
+    {
+        for (int index = from; index < m_length; index++) {
+            if (m_data[index] == '\n')
+                return index;
+        }
+        return -1;
+    }
+
+    inline int characterClass(const LexicalTransitionTable &table, int index, int &characterLength) const
+    {
+        if (m_data[index] < 0x80) {
+            characterLength = 1;
+            return table.characterClass(QChar(ushort(m_data[index])));
+        }
+        return table.characterClass(this->decodeCharacter(index, characterLength));
+    }
+
+    inline int nextCharacterIndex(int index) const
+    {
+        int characterLength = 1;
+        if (m_data[index] >= 0x80)
+            this->decodeCharacter(index, characterLength);
+        return index + characterLength;
+    }
+
+    inline int characterRunEnd(const CharacterRunScanner &characterRun, int index) const
+    {
+        return characterRun.runEnd(reinterpret_cast<const char *>(m_data), index, m_length);
+    }
+
+    inline int utf16Length(int index, int length) const
+    {
+        int utf16Length = 0;
+        const int endIndex = index + length;
+        while (index < endIndex) {
+            int characterLength = 1;
+            // Characters out of BMP are surrogate pairs in QString
+            if ((m_data[index] >= 0x80) && (this->decodeCharacter(index, characterLength).isHighSurrogate()))
+                utf16Length++;
+            utf16Length++;
+            index += characterLength;
+        }
+        return utf16Length;
+    }
+
+    inline int keywordIndex(const PerfectHash &keywordPerfectHash, int index, int length) const
+    {
+        if (this->isAscii(index, length))
+            return keywordPerfectHash.indexOf(reinterpret_cast<const char *>(m_data) + index, length);
+        return keywordPerfectHash.indexOf(QString::fromUtf8(reinterpret_cast<const char *>(m_data) + index, length));
+    }
+
+    inline int intern(StringPool &stringPool, int index, int length) const
+    {
+        if (this->isAscii(index, length))
+            return stringPool.intern(reinterpret_cast<const char *>(m_data) + index, length);
+        return stringPool.intern(QString::fromUtf8(reinterpret_cast<const char *>(m_data) + index, length));
+    }
+
+    inline NumberLiteral decodeNumberLiteral(int index, int length, Expression::Type type) const
+    {
+        return NumberLiteral::decode(reinterpret_cast<const char *>(m_data) + index, length, type);
+    }
+
+    inline TokenStream tokenStream(int beginIndex) const
+    {
+        return TokenStream(m_sourceCode, beginIndex);
+    }
+
+private:
+
+    inline bool isAscii(int index, int length) const
+    {
+        for (int i = index; i < index + length; i++) {
+            if (m_data[i] >= 0x80)
+                return false;
+        }
+        return true;
+    }
+
+    /*!
+     * This method used to decode not ASCII character.
+     *
+     * @param[in] index Index of first byte of character.
+     * @param[out] characterLength Count of bytes of character.
+     * @return Character. Character out of BMP is returned as high surrogate, wrong byte as replacement character.
+     */
+    inline QChar decodeCharacter(int index, int &characterLength) const
+    {
+        const uchar firstByte = m_data[index];
+        int continuationCount = 0;
+        uint code = 0;
+        uint minCode = 0;
+        if ((firstByte >= 0xC2) && (firstByte < 0xE0)) {
+            continuationCount = 1;
+            code = firstByte & 0x1F;
+            minCode = 0x80;
+        } else if ((firstByte >= 0xE0) && (firstByte < 0xF0)) {
+            continuationCount = 2;
+            code = firstByte & 0x0F;
+            minCode = 0x800;
+        } else if ((firstByte >= 0xF0) && (firstByte < 0xF5)) {
+            continuationCount = 3;
+            code = firstByte & 0x07;
+            minCode = 0x10000;
+        }
+
+        characterLength = 1;
+        if ((continuationCount == 0) || (index + continuationCount >= m_length))
+            return QChar(QChar::ReplacementCharacter);
+        for (int i = 1; i <= continuationCount; i++) {
+            const uchar byte = m_data[index + i];
+            if ((byte & 0xC0) != 0x80)
+                return QChar(QChar::ReplacementCharacter);
+            code = (code << 6) | (byte & 0x3F);
+        }
+        if ((code < minCode) || (code > 0x10FFFF) || ((code >= 0xD800) && (code <= 0xDFFF)))
+            return QChar(QChar::ReplacementCharacter);
+
+        characterLength = continuationCount + 1;
+        if (code > 0xFFFF)
+            return QChar(QChar::highSurrogate(code));
+        return QChar(ushort(code));
+    }
+
+    const Utf8SourceCode &m_sourceCode;     //!< Source code.
+    const uchar *m_data;                    //!< Bytes of source code.
+    int m_length;                           //!< Count of bytes.
+
+};
+
+#endif // SOURCETEXT_H
@@ -0,0 +1,115 @@
+#include "StringPool.h"
+#include "PerfectHash.h"
+
+static inline QString MakeString(const QChar *string, int length)
+{
+    return QString(string, length);
+}
+
+static inline QString MakeString(const char *string, int length)
+{
+    return QString::fromLatin1(string, length);
+}
+
+StringPool::StringPool()
+{
+    m_slots.fill(-1, MIN_SLOT_COUNT);
+}
+
+int StringPool::intern(const QChar *string, int length)
+{
+    return this->internString(string, length);
+}
+
+int StringPool::intern(const char *string, int length)
+{
+    return this->internString(string, length);
+}
+
+int StringPool::intern(const QString &string)
+{
+    return this->internString(string.unicode(), string.length());
+}
+
+template <typename Char>
+int StringPool::internString(const Char *string, int length)
+{
+    const quint32 hash = PerfectHashFunction(string, length, 0);
+    int slot = this->findSlot(string, length, hash);
+    if (m_slots.at(slot) >= 0)
+        return m_slots.at(slot);
+
+    // Table is kept at most half full
+    if ((m_strings.size() + 1) * 2 > m_slots.size()) {
+        this->grow();
+        slot = this->findSlot(string, length, hash);
+    }
+    const int id = m_strings.size();
+    m_strings.append(MakeString(string, length));
+    m_hashes.append(hash);
+    m_slots[slot] = id;
+    return id;
+}
+
+int StringPool::indexOf(const QChar *string, int length) const
+{
+    return m_slots.at(this->findSlot(string, length, PerfectHashFunction(string, length, 0)));
+}
+
+int StringPool::indexOf(const char *string, int length) const
+{
+    return m_slots.at(this->findSlot(string, length, PerfectHashFunction(string, length, 0)));
+}
+
+int StringPool::indexOf(const QString &string) const
+{
+    return this->indexOf(string.unicode(), string.length());
+}
+
+QString StringPool::string(int id) const
+{
+    return m_strings.at(id);
+}
+
+int StringPool::size() const
+{
+    return m_strings.size();
+}
+
+void StringPool::clear()
+{
+    m_strings.clear();
+    m_hashes.clear();
+    m_slots.fill(-1, MIN_SLOT_COUNT);
+}
+
+template <typename Char>
+int StringPool::findSlot(const Char *string, int length, quint32 hash) const
+{
+    const int mask = m_slots.size() - 1;
+    for (int slot = hash & mask; ; slot = (slot + 1) & mask) {
+        const int id = m_slots.at(slot);
+        if (id < 0)
+            return slot;
+        if ((m_hashes.at(id) != hash) || (m_strings.at(id).length() != length))
+            continue;
+        const QChar *slotString = m_strings.at(id).unicode();
+        int i = 0;
+        while ((i < length) && (slotString[i].unicode() == CharacterCode(string[i])))
+            i++;
+        if (i == length)
+            return slot;
+    }
+}
+
+void StringPool::grow()
+{
+    const int mask = m_slots.size() * 2 - 1;
+    m_slots.fill(-1, m_slots.size() * 2);
+    for (int id = 0; id < m_strings.size(); id++) {
+        int slot = m_hashes.at(id) & mask;
+        while (m_slots.at(slot) >= 0)
+            slot = (slot + 1) & mask;
+        m_slots[slot] = id;
+    }
+}
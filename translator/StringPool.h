@@ -0,0 +1,76 @@
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include <QString>
+#include <QVector>
+#include <QChar>
+
+/*!
+ * @brief This class used to intern strings. (e.g. lexemes of identifiers and literals)
+ *
+ * Every different string gets dense id in order of adding, so equal strings have equal ids and strings can be
+ * compared and hashed as integers. Strings are found by open addressing hash table of ids.
+ */
+class StringPool
+{
+
+public:
+
+    StringPool();
+
+    /*!
+     * This method used to add string to pool.
+     *
+     * @param[in] string Pointer on first character of string. Bytes are Latin-1 characters.
+     * @param[in] length Length of string.
+     * @return Id of string. If string was added before returns its id.
+     */
+    int intern(const QChar *string, int length);
+    int intern(const char *string, int length);
+    int intern(const QString &string);
+
+    /*!
+     * This method used to find string in pool without adding.
+     *
+     * @param[in] string Pointer on first character of string.
+     * @param[in] length Length of string.
+     * @return Id of string or -1 if there is no such string.
+     */
+    int indexOf(const QChar *string, int length) const;
+    int indexOf(const char *string, int length) const;
+    int indexOf(const QString &string) const;
+
+    QString string(int id) const;
+    int size() const;
+    void clear();
+
+private:
+
+    template <typename Char>
+    int internString(const Char *string, int length);
+
+    /*!
+     * This method used to find slot of string in hash table.
+     *
+     * @param[in] string Pointer on first character of string.
+     * @param[in] length Length of string.
+     * @param[in] hash Hash of string.
+     * @return Index of slot with string id or of first empty slot.
+     */
+    template <typename Char>
+    int findSlot(const Char *string, int length, quint32 hash) const;
+
+    /*!
+     * This method used to make hash table twice bigger.
+     */
+    void grow();
+
+    QVector<QString> m_strings;     //!< Strings by id.
+    QVector<quint32> m_hashes;      //!< Hash of each string by id.
+    QVector<int> m_slots;           //!< Hash table of ids, -1 is empty slot. Size is power of two.
+
+    static const int MIN_SLOT_COUNT = 64;   //!< Size of empty hash table.
+
+};
+
+#endif // STRINGPOOL_H
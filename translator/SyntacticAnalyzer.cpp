@@ -1,105 +1,770 @@
 #include "SyntacticAnalyzer.h"
 #include "ErrorGenerator.h"
+#include "TokenCursor.h"
+#include <algorithm>
+
+const int SyntacticAnalyzer::DEFAULT_MAX_ERROR_COUNT;
+
+/*!
+ * This function used to get last child of node.
+ *
+ * @param[in] syntaxTree Syntax tree.
+ * @param[in] node Index of node.
+ * @return Index of last child or -1 if node has no children.
+ */
+static int LastChild(const SyntaxTree &syntaxTree, int node)
+{
+    int childCount = syntaxTree.childCount(node);
+    return (childCount > 0) ? syntaxTree.child(node, childCount - 1) : -1;
+}
+
+SyntacticAnalyzer::SyntacticAnalyzer() :
+    m_isParseTableBuilt(false),
+    m_isSyntaxTreeEnabled(true),
+    m_isTokenStreamAnalyzed(false),
+    m_analyzedTreeSize(0),
+    m_parseEventHandler(NULL),
+    m_generatedParser(NULL),
+    m_tokenIndex(0),
+    m_maxErrorCount(DEFAULT_MAX_ERROR_COUNT),
+    m_isTracingEnabled(true),
+    m_startSymbol("S", SyntacticSymbol::START_SYMBOL)
+{}
 
 void SyntacticAnalyzer::addProductRule(const SyntacticSymbol &firstSymbol, const QList<SyntacticSymbol> &productionList)
 {
-    int ruleNumber = m_productRules.size();
-    m_productRules.insert(firstSymbol, Production(ruleNumber,productionList));
+    int ruleNumber = m_productions.size();
+    QList<SyntacticSymbol> symbolList = productionList;
+    for (int i = 0; i < symbolList.size(); i++) {
+        const SyntacticSymbol &symbol = symbolList.at(i);
+        if (symbol.type() == SyntacticSymbol::TERMINAL_SYMBOL) {
+            int terminalId = m_terminalIdTable.addTerminal(symbol.category(), symbol.name());
+            symbolList[i].setTerminalId(terminalId);
+            if (terminalId == m_terminals.size())
+                m_terminals.append(symbolList.at(i));
+        } else {
+            this->addNonterminal(symbol);
+        }
+    }
+    m_productions.append(Production(ruleNumber, symbolList));
+    m_productionNonterminals.append(this->addNonterminal(firstSymbol));
+    m_isParseTableBuilt = false;
+    m_generatedParser = NULL;
+    m_isTokenStreamAnalyzed = false;
+}
+
+void SyntacticAnalyzer::buildParseTable()
+{
+    this->calculateFirstSets();
+    this->calculateFollowSets();
+
+    // Last column of table is end of source code
+    const int columnCount = m_terminals.size() + 1;
+    m_grammarDiagnostics.clear();
+    m_parseTable.fill(-1, m_nonterminals.size() * columnCount);
+    m_nullableRules.fill(-1, m_nonterminals.size());
+    for (int i = 0; i < m_productions.size(); i++) {
+        int nonterminal = m_productionNonterminals.at(i);
+        QVector<bool> firstSet(columnCount, false);
+        bool isNullable = this->addFirstSet(m_productions.at(i).syntacticSymbolList(), 0, firstSet);
+        for (int terminalId = 0; terminalId < m_terminals.size(); terminalId++) {
+            if (firstSet.at(terminalId))
+                this->setTableRule(nonterminal, terminalId, i);
+        }
+        if (!isNullable)
+            continue;
+        if (m_nullableRules.at(nonterminal) < 0) {
+            m_nullableRules[nonterminal] = i;
+        } else {
+            m_grammarDiagnostics.append(ErrorGenerator::grammarConflictError(m_nonterminals.at(nonterminal),
+                                                                             MakeStringRepresentation(QList<SyntacticSymbol>()),
+                                                                             m_nullableRules.at(nonterminal) + 1,
+                                                                             i + 1));
+        }
+    }
+
+    for (int nonterminal = 0; nonterminal < m_nonterminals.size(); nonterminal++) {
+        int nullableRule = m_nullableRules.at(nonterminal);
+        if (nullableRule < 0)
+            continue;
+        for (int column = 0; column < columnCount; column++) {
+            if (m_followSets.at(nonterminal).at(column))
+                this->setTableRule(nonterminal, column, nullableRule);
+        }
+        // Rule for empty string is used for other terminals too, so error is found at next terminal as before
+        for (int column = 0; column < columnCount; column++) {
+            if (m_parseTable.at(nonterminal * columnCount + column) < 0)
+                m_parseTable[nonterminal * columnCount + column] = nullableRule;
+        }
+    }
+    m_isParseTableBuilt = true;
+}
+
+bool SyntacticAnalyzer::setParseTable(const QVector<int> &parseTable,
+                                      const QVector<int> &nullableRules,
+                                      const QVector<bool> &firstSets,
+                                      const QVector<bool> &followSets,
+                                      const DiagnosticList &grammarDiagnostics)
+{
+    const int columnCount = m_terminals.size() + 1;
+    const int cellCount = m_nonterminals.size() * columnCount;
+    if ((parseTable.size() != cellCount)
+            || (nullableRules.size() != m_nonterminals.size())
+            || (firstSets.size() != cellCount)
+            || (followSets.size() != cellCount))
+        return false;
+
+    m_parseTable = parseTable;
+    m_nullableRules = nullableRules;
+    m_firstSets.resize(m_nonterminals.size());
+    m_followSets.resize(m_nonterminals.size());
+    for (int nonterminal = 0; nonterminal < m_nonterminals.size(); nonterminal++) {
+        m_firstSets[nonterminal] = firstSets.mid(nonterminal * columnCount, columnCount);
+        m_followSets[nonterminal] = followSets.mid(nonterminal * columnCount, columnCount);
+    }
+    m_grammarDiagnostics = grammarDiagnostics;
+    m_isParseTableBuilt = true;
+    return true;
+}
+
+bool SyntacticAnalyzer::isParseTableBuilt() const
+{
+    return m_isParseTableBuilt;
+}
+
+const DiagnosticList &SyntacticAnalyzer::grammarDiagnostics() const
+{
+    return m_grammarDiagnostics;
 }
 
 void SyntacticAnalyzer::analyze(const QList<Token> &tokenList)
 {
-    this->prepareToAnalysis(tokenList);
-    // LL(1) analysis
-    while (!m_tokenToParseList.isEmpty()&&!m_symbolToParseList.isEmpty()) {
-        Token firstTokenToParse = m_tokenToParseList.first();
-        SyntacticSymbol firstSymbolToParse = m_symbolToParseList.first();
-        if (firstSymbolToParse == firstTokenToParse) {
-            m_tokenToParseList.takeFirst();
-            m_symbolToParseList.takeFirst();
+    if (this->hasGeneratedParser()) {
+        TokenCursor generatedParserCursor(tokenList);
+        if (this->analyzeByGeneratedParser(generatedParserCursor))
+            return;
+    }
+    TokenCursor tokenCursor(tokenList);
+    this->analyze(tokenCursor);
+}
+
+void SyntacticAnalyzer::analyze(const TokenStream &tokenStream)
+{
+    bool isAnalyzed = false;
+    if (this->hasGeneratedParser()) {
+        TokenCursor generatedParserCursor(tokenStream);
+        isAnalyzed = this->analyzeByGeneratedParser(generatedParserCursor);
+    }
+    if (!isAnalyzed) {
+        TokenCursor tokenCursor(tokenStream);
+        this->analyze(tokenCursor);
+    }
+    m_isTokenStreamAnalyzed = true;
+    m_analyzedTreeSize = m_syntaxTree.size();
+}
+
+void SyntacticAnalyzer::reanalyze(const TokenStream &tokenStream, int beginIndex, int removedCount, int addedCount)
+{
+    // Unreachable nodes of old subtrees stay in arena, so tree is built again when it grows too much
+    bool canReparse = m_isTokenStreamAnalyzed
+            && m_isSyntaxTreeEnabled
+            && (m_parseEventHandler == NULL)
+            && m_diagnostics.isEmpty()
+            && (beginIndex > 0)
+            && (beginIndex + removedCount <= m_tokenIndex)
+            && (m_tokenIndex + addedCount - removedCount == tokenStream.size())
+            && (m_syntaxTree.size() <= 2 * m_analyzedTreeSize);
+    if (canReparse) {
+        if (!m_isParseTableBuilt)
+            this->buildParseTable();
+        if (this->reparse(tokenStream, beginIndex, removedCount, addedCount))
+            return;
+    }
+    this->analyze(tokenStream);
+}
+
+bool SyntacticAnalyzer::analyzeByGeneratedParser(TokenCursor &tokenCursor)
+{
+    this->prepareToAnalysis();
+    tokenCursor.setTerminalIdTable(m_terminalIdTable);
+    GeneratedParserContext context(this, &tokenCursor);
+    return m_generatedParser(context);
+}
+
+void SyntacticAnalyzer::analyze(TokenCursor &tokenCursor)
+{
+    if (!m_isParseTableBuilt)
+        this->buildParseTable();
+    this->prepareToAnalysis();
+    tokenCursor.setTerminalIdTable(m_terminalIdTable);
+    this->parse(tokenCursor);
+    this->exitRules(0);
+}
+
+void SyntacticAnalyzer::parse(TokenCursor &tokenCursor)
+{
+    // LL(1) analysis, tokens are matched with terminals by ids
+    while (!tokenCursor.atEnd()&&!m_symbolStack.isEmpty()) {
+        int terminalId = tokenCursor.peekTerminalId();
+        SyntacticSymbol firstSymbolToParse = m_symbolStack.last();
+        if ((terminalId != TerminalIdTable::UNKNOWN_TERMINAL) && (firstSymbolToParse.terminalId() == terminalId)) {
+            if (m_isSyntaxTreeEnabled)
+                m_syntaxTree.setTokenIndex(m_nodeStack.last(), m_tokenIndex);
+            if (m_parseEventHandler)
+                m_parseEventHandler->shiftToken(tokenCursor.peek(), m_tokenIndex);
+            this->skipToken(tokenCursor);
+            m_symbolStack.removeLast();
+            m_nodeStack.removeLast();
+            if (m_parseEventHandler)
+                this->exitRules(m_symbolStack.size());
         } else {
-            Production production = this->findCongruentRule(firstSymbolToParse, firstTokenToParse);
-            if (production.syntacticSymbolList().isEmpty() && (!isLambdaRuleExists(firstSymbolToParse))) {
-                this->addError(ErrorGenerator::syntacticError(m_tokenToParseList, m_symbolToParseList));
-                m_tokenToParseList.takeFirst();
-                return;
+            int ruleNumber = this->findRule(firstSymbolToParse, terminalId);
+            if (ruleNumber < 0) {
+                this->addSyntacticError(tokenCursor);
+                if ((m_maxErrorCount > 0) && (m_diagnostics.size() >= m_maxErrorCount)) {
+                    this->skipToken(tokenCursor);
+                    return;
+                }
+                this->recoverFromError(tokenCursor);
+                continue;
             }
-            m_symbolToParseList.takeFirst();
-            m_symbolToParseList = production.syntacticSymbolList() + m_symbolToParseList;
-            this->useRule(production.number() + 1, firstSymbolToParse, production.syntacticSymbolList());
+            const Production &production = m_productions.at(ruleNumber);
+            int node = m_nodeStack.last();
+            m_symbolStack.removeLast();
+            m_nodeStack.removeLast();
+            int firstChild = m_isSyntaxTreeEnabled ? m_syntaxTree.addChildren(node, ruleNumber, production.syntacticSymbolList()) : -1;
+            if (m_parseEventHandler)
+                this->enterRule(ruleNumber);
+            this->pushSymbols(production.syntacticSymbolList(), firstChild);
+            this->useRule(ruleNumber);
+            if (m_parseEventHandler)
+                this->exitRules(m_symbolStack.size());
         }
     }
 
-    while (!m_symbolToParseList.isEmpty()) {
-        SyntacticSymbol symbol = m_symbolToParseList.takeFirst();
-        while (symbol.category() == Token::LINE_FEED_CATEGORY) {
-            symbol = m_symbolToParseList.takeFirst();
-        }
-        if (!isLambdaRuleExists(symbol)) {
-            this->addError(ErrorGenerator::syntacticError(m_tokenToParseList, m_symbolToParseList));
+    while (!m_symbolStack.isEmpty()) {
+        SyntacticSymbol symbol = m_symbolStack.last();
+        m_symbolStack.removeLast();
+        m_nodeStack.removeLast();
+        if (m_parseEventHandler)
+            this->exitRules(m_symbolStack.size());
+        if (symbol.category() == Token::LINE_FEED_CATEGORY)
+            continue;
+        if (!this->isNullable(symbol)) {
+            this->addSyntacticError(tokenCursor);
             return;
         }
     }
-    if (!m_tokenToParseList.isEmpty())
-        this->addError(ErrorGenerator::syntacticError(m_tokenToParseList, m_symbolToParseList));
+    if (!tokenCursor.atEnd())
+        this->addSyntacticError(tokenCursor);
 }
 
-Production SyntacticAnalyzer::findCongruentRule(const SyntacticSymbol &firstSymbol, const Token &firstProductSymbol) const
+bool SyntacticAnalyzer::reparse(const TokenStream &tokenStream, int beginIndex, int removedCount, int addedCount)
 {
-    foreach (Production production, m_productRules.values(firstSymbol)) {
-        if (!production.syntacticSymbolList().isEmpty()) {
-            if (production.getFirstSymbol() == firstProductSymbol) {
-                return production;
+    // Rules are chosen by next token, so subtree must contain token before change and token after it
+    const int endIndex = beginIndex + removedCount;
+    const int sizeDelta = addedCount - removedCount;
+    const int oldTokenCount = m_tokenIndex;
+    int node = m_syntaxTree.commonAncestor(m_syntaxTree.tokenNode(beginIndex - 1),
+                                           m_syntaxTree.tokenNode(qMin(endIndex, oldTokenCount - 1)));
+    if ((node >= 0) && m_syntaxTree.isToken(node))
+        node = m_syntaxTree.parent(node);
+    if ((node < 0) || (m_syntaxTree.ruleNumber(node) < 0))
+        return false;
+
+    const int oldFirstChild = m_syntaxTree.child(node, 0);
+    const int oldChildCount = m_syntaxTree.childCount(node);
+    const int ruleBeginIndex = m_syntaxTree.usedRuleIndex(node);
+    int reusableNode = LastChild(m_syntaxTree, node);
+    int reusableTokenIndex = (reusableNode >= 0) ? m_syntaxTree.firstTokenIndex(reusableNode) : -1;
+
+    m_symbolStack.clear();
+    m_nodeStack.clear();
+    m_symbolStack << m_nonterminals.at(m_productionNonterminals.at(m_syntaxTree.ruleNumber(node)));
+    m_nodeStack << node;
+    m_tokenIndex = m_syntaxTree.firstTokenIndex(node);
+    m_syntaxTree.beginReplacement(node, beginIndex, removedCount, addedCount);
+    TokenCursor tokenCursor(tokenStream, m_tokenIndex);
+    tokenCursor.setTerminalIdTable(m_terminalIdTable);
+
+    // Rules of subtree are used in the same order as by parse(), they replace old rules of subtree
+    QVector<int> newRules;
+    int oldRuleEndIndex = -1;
+    bool isSubtreeReused = false;
+    while (!tokenCursor.atEnd() && !m_symbolStack.isEmpty()) {
+        int terminalId = tokenCursor.peekTerminalId();
+        SyntacticSymbol firstSymbolToParse = m_symbolStack.last();
+
+        // Last symbol of subtree is parsed after change, old node of this symbol is looked for in last children
+        if ((m_symbolStack.size() == 1) && (m_tokenIndex >= endIndex + sizeDelta)) {
+            while ((reusableTokenIndex >= 0) && (reusableTokenIndex < m_tokenIndex - sizeDelta)) {
+                reusableNode = LastChild(m_syntaxTree, reusableNode);
+                reusableTokenIndex = (reusableNode >= 0) ? m_syntaxTree.firstTokenIndex(reusableNode) : -1;
+            }
+            if ((reusableTokenIndex == m_tokenIndex - sizeDelta)
+                    && (m_syntaxTree.ruleNumber(reusableNode) >= 0)
+                    && (m_syntaxTree.symbolId(reusableNode) == firstSymbolToParse.id())) {
+                oldRuleEndIndex = m_syntaxTree.usedRuleIndex(reusableNode);
+                m_syntaxTree.moveSubtree(reusableNode, m_nodeStack.last());
+                m_symbolStack.clear();
+                m_nodeStack.clear();
+                isSubtreeReused = true;
+                break;
+            }
+        }
+
+        if ((terminalId != TerminalIdTable::UNKNOWN_TERMINAL) && (firstSymbolToParse.terminalId() == terminalId)) {
+            m_syntaxTree.setTokenIndex(m_nodeStack.last(), m_tokenIndex);
+            this->skipToken(tokenCursor);
+            m_symbolStack.removeLast();
+            m_nodeStack.removeLast();
+        } else {
+            int ruleNumber = this->findRule(firstSymbolToParse, terminalId);
+            if (ruleNumber < 0)
+                return false;
+            const Production &production = m_productions.at(ruleNumber);
+            int firstChild = m_syntaxTree.addChildren(m_nodeStack.last(), ruleNumber, production.syntacticSymbolList());
+            m_symbolStack.removeLast();
+            m_nodeStack.removeLast();
+            this->pushSymbols(production.syntacticSymbolList(), firstChild);
+            if (m_isTracingEnabled)
+                newRules.append(ruleNumber);
+        }
+    }
+
+    if (!isSubtreeReused) {
+        // Symbols at the end of source code are removed without rules as by parse()
+        while (!m_symbolStack.isEmpty()) {
+            SyntacticSymbol symbol = m_symbolStack.last();
+            m_symbolStack.removeLast();
+            m_nodeStack.removeLast();
+            if ((symbol.category() != Token::LINE_FEED_CATEGORY) && !this->isNullable(symbol))
+                return false;
+        }
+
+        // Subtree must end before the same token, otherwise rules after it are changed
+        int oldLastTokenIndex = -1;
+        for (int i = oldChildCount - 1; (i >= 0) && (oldLastTokenIndex < 0); i--)
+            oldLastTokenIndex = m_syntaxTree.lastTokenIndex(oldFirstChild + i);
+        if (m_tokenIndex != oldLastTokenIndex + 1 + sizeDelta)
+            return false;
+
+        // Whole subtree was parsed, so its old rules are counted in time of parsing
+        QVector<int> oldRules;
+        for (int i = 0; i < oldChildCount; i++)
+            m_syntaxTree.appendRuleNumbers(oldFirstChild + i, oldRules);
+        oldRuleEndIndex = ruleBeginIndex + 1 + oldRules.size();
+    }
+
+    // Nodes after parsed part are old, their tokens and rules are moved when they are read
+    const int oldRuleCount = oldRuleEndIndex - ruleBeginIndex;
+    const int newRuleCount = m_syntaxTree.nextUsedRuleIndex() - ruleBeginIndex;
+    m_syntaxTree.endReplacement(endIndex, sizeDelta, oldRuleEndIndex, newRuleCount - oldRuleCount);
+    m_tokenIndex = tokenStream.size();
+    if (m_isTracingEnabled) {
+        m_usedRules.remove(ruleBeginIndex, oldRuleCount);
+        m_usedRules.insert(ruleBeginIndex, newRuleCount, -1);
+        std::copy(newRules.begin(), newRules.end(), m_usedRules.begin() + ruleBeginIndex);
+    }
+    return true;
+}
+
+int SyntacticAnalyzer::findRule(const SyntacticSymbol &symbol, int terminalId) const
+{
+    if (symbol.type() == SyntacticSymbol::TERMINAL_SYMBOL)
+        return -1;
+    int nonterminal = this->nonterminalIndex(symbol);
+    if (nonterminal < 0)
+        return -1;
+
+    // Token which is not terminal is parsed only by rule for empty string
+    const int columnCount = m_terminals.size() + 1;
+    int column = (terminalId == TerminalIdTable::UNKNOWN_TERMINAL) ? m_terminals.size() : terminalId;
+    return m_parseTable.at(nonterminal * columnCount + column);
+}
+
+bool SyntacticAnalyzer::isNullable(const SyntacticSymbol &symbol) const
+{
+    if (symbol.type() == SyntacticSymbol::TERMINAL_SYMBOL)
+        return false;
+    int nonterminal = this->nonterminalIndex(symbol);
+    return (nonterminal >= 0) && (m_nullableRules.at(nonterminal) >= 0);
+}
+
+int SyntacticAnalyzer::nonterminalIndex(const SyntacticSymbol &symbol) const
+{
+    int id = symbol.id();
+    if ((id < 0) || (id >= m_nonterminalIndexes.size()))
+        return -1;
+    return m_nonterminalIndexes.at(id);
+}
+
+int SyntacticAnalyzer::addNonterminal(const SyntacticSymbol &symbol)
+{
+    int index = this->nonterminalIndex(symbol);
+    if (index >= 0)
+        return index;
+
+    // Incorrect symbol has no id, it gets new index every time
+    index = m_nonterminals.size();
+    m_nonterminals.append(symbol);
+    if (symbol.id() >= 0) {
+        if (symbol.id() >= m_nonterminalIndexes.size())
+            m_nonterminalIndexes += QVector<int>(symbol.id() + 1 - m_nonterminalIndexes.size(), -1);
+        m_nonterminalIndexes[symbol.id()] = index;
+    }
+    return index;
+}
+
+void SyntacticAnalyzer::calculateFirstSets()
+{
+    m_firstSets.fill(QVector<bool>(m_terminals.size() + 1, false), m_nonterminals.size());
+    m_nullableNonterminals.fill(false, m_nonterminals.size());
+    bool isChanged = true;
+    while (isChanged) {
+        isChanged = false;
+        for (int i = 0; i < m_productions.size(); i++) {
+            int nonterminal = m_productionNonterminals.at(i);
+            QVector<bool> firstSet = m_firstSets.at(nonterminal);
+            bool isNullable = this->addFirstSet(m_productions.at(i).syntacticSymbolList(), 0, firstSet);
+            if (firstSet != m_firstSets.at(nonterminal)) {
+                m_firstSets[nonterminal] = firstSet;
+                isChanged = true;
+            }
+            if (isNullable && !m_nullableNonterminals.at(nonterminal)) {
+                m_nullableNonterminals[nonterminal] = true;
+                isChanged = true;
+            }
+        }
+    }
+}
+
+void SyntacticAnalyzer::calculateFollowSets()
+{
+    m_followSets.fill(QVector<bool>(m_terminals.size() + 1, false), m_nonterminals.size());
+    int startNonterminal = this->nonterminalIndex(m_startSymbol);
+    if (startNonterminal >= 0)
+        m_followSets[startNonterminal][m_terminals.size()] = true;
+
+    bool isChanged = true;
+    while (isChanged) {
+        isChanged = false;
+        for (int i = 0; i < m_productions.size(); i++) {
+            int nonterminal = m_productionNonterminals.at(i);
+            const QList<SyntacticSymbol> rightPart = m_productions.at(i).syntacticSymbolList();
+            for (int j = 0; j < rightPart.size(); j++) {
+                if (rightPart.at(j).type() == SyntacticSymbol::TERMINAL_SYMBOL)
+                    continue;
+                int symbolNonterminal = this->nonterminalIndex(rightPart.at(j));
+                QVector<bool> followSet = m_followSets.at(symbolNonterminal);
+                if (this->addFirstSet(rightPart, j + 1, followSet)) {
+                    for (int column = 0; column < followSet.size(); column++)
+                        followSet[column] = followSet.at(column) || m_followSets.at(nonterminal).at(column);
+                }
+                if (followSet != m_followSets.at(symbolNonterminal)) {
+                    m_followSets[symbolNonterminal] = followSet;
+                    isChanged = true;
+                }
             }
         }
     }
-    return this->findLambdaRule(firstSymbol);
 }
 
-Production SyntacticAnalyzer::findLambdaRule(const SyntacticSymbol &firstSymbol) const
+bool SyntacticAnalyzer::addFirstSet(const QList<SyntacticSymbol> &rightPart, int beginIndex, QVector<bool> &set) const
+{
+    for (int i = beginIndex; i < rightPart.size(); i++) {
+        const SyntacticSymbol &symbol = rightPart.at(i);
+        if (symbol.type() == SyntacticSymbol::TERMINAL_SYMBOL) {
+            set[symbol.terminalId()] = true;
+            return false;
+        }
+        int nonterminal = this->nonterminalIndex(symbol);
+        const QVector<bool> &firstSet = m_firstSets.at(nonterminal);
+        for (int terminalId = 0; terminalId < firstSet.size(); terminalId++)
+            set[terminalId] = set.at(terminalId) || firstSet.at(terminalId);
+        if (!m_nullableNonterminals.at(nonterminal))
+            return false;
+    }
+    return true;
+}
+
+void SyntacticAnalyzer::setTableRule(int nonterminal, int terminalId, int ruleNumber)
+{
+    int &tableRule = m_parseTable[nonterminal * (m_terminals.size() + 1) + terminalId];
+    if (tableRule < 0) {
+        tableRule = ruleNumber;
+    } else if (tableRule != ruleNumber) {
+        m_grammarDiagnostics.append(ErrorGenerator::grammarConflictError(m_nonterminals.at(nonterminal),
+                                                                         this->terminalRepresentation(terminalId),
+                                                                         tableRule + 1,
+                                                                         ruleNumber + 1));
+    }
+}
+
+QString SyntacticAnalyzer::terminalRepresentation(int terminalId) const
+{
+    if (terminalId == m_terminals.size())
+        return "end of source code";
+    return MakeStringRepresentation(m_terminals.at(terminalId));
+}
+
+void SyntacticAnalyzer::pushSymbols(const QList<SyntacticSymbol> &rightPart, int firstNode)
 {
-    foreach (Production production, m_productRules.values(firstSymbol)) {
-        if (production.syntacticSymbolList().isEmpty())
-            return production;
+    for (int i = rightPart.size() - 1; i >= 0; i--) {
+        m_symbolStack.append(rightPart.at(i));
+        m_nodeStack.append((firstNode < 0) ? -1 : firstNode + i);
     }
-    return Production();
 }
 
-bool SyntacticAnalyzer::isLambdaRuleExists(const SyntacticSymbol &firstSymbol)
+void SyntacticAnalyzer::enterRule(int ruleNumber)
+{
+    m_parseEventHandler->enterRule(m_nonterminals.at(m_productionNonterminals.at(ruleNumber)), ruleNumber);
+    m_enteredRules.append(ruleNumber);
+    m_enteredRuleStackSizes.append(m_symbolStack.size());
+}
+
+void SyntacticAnalyzer::exitRules(int stackSize)
 {
-    foreach (Production production, m_productRules.values(firstSymbol)) {
-        if (production.syntacticSymbolList().isEmpty())
-            return true;
+    while (!m_enteredRules.isEmpty() && (m_enteredRuleStackSizes.last() >= stackSize)) {
+        int ruleNumber = m_enteredRules.last();
+        m_enteredRules.removeLast();
+        m_enteredRuleStackSizes.removeLast();
+        if (m_parseEventHandler)
+            m_parseEventHandler->exitRule(ruleNumber);
     }
-    return false;
 }
 
-void SyntacticAnalyzer::prepareToAnalysis(const QList<Token> &tokenList)
+void SyntacticAnalyzer::skipToken(TokenCursor &tokenCursor)
+{
+    tokenCursor.skipToken();
+    m_tokenIndex++;
+}
+
+bool SyntacticAnalyzer::canBeginWith(const SyntacticSymbol &symbol, int terminalId) const
+{
+    if (symbol.type() == SyntacticSymbol::TERMINAL_SYMBOL)
+        return symbol.terminalId() == terminalId;
+    int nonterminal = this->nonterminalIndex(symbol);
+    return (nonterminal >= 0) && m_firstSets.at(nonterminal).at(terminalId);
+}
+
+void SyntacticAnalyzer::recoverFromError(TokenCursor &tokenCursor)
+{
+    QVector<bool> synchronizingSet(m_terminals.size(), false);
+    for (int terminalId = 0; terminalId < m_terminals.size(); terminalId++)
+        synchronizingSet[terminalId] = (m_terminals.at(terminalId).category() == Token::LINE_FEED_CATEGORY);
+    foreach (const SyntacticSymbol &symbol, m_symbolStack) {
+        int nonterminal = this->nonterminalIndex(symbol);
+        if ((symbol.type() == SyntacticSymbol::TERMINAL_SYMBOL) || (nonterminal < 0))
+            continue;
+        for (int terminalId = 0; terminalId < m_terminals.size(); terminalId++)
+            synchronizingSet[terminalId] = synchronizingSet.at(terminalId) || m_followSets.at(nonterminal).at(terminalId);
+    }
+
+    // Synchronizing token which no symbol to parse can begin with is skipped too
+    while (!tokenCursor.atEnd()) {
+        int terminalId = tokenCursor.peekTerminalId();
+        if ((terminalId != TerminalIdTable::UNKNOWN_TERMINAL) && synchronizingSet.at(terminalId)) {
+            for (int i = m_symbolStack.size() - 1; i >= 0; i--) {
+                if (this->canBeginWith(m_symbolStack.at(i), terminalId)) {
+                    m_symbolStack.resize(i + 1);
+                    m_nodeStack.resize(i + 1);
+                    if (m_parseEventHandler)
+                        this->exitRules(m_symbolStack.size());
+                    return;
+                }
+            }
+        }
+        this->skipToken(tokenCursor);
+    }
+}
+
+void SyntacticAnalyzer::prepareToAnalysis()
+{
+    m_symbolStack.clear();
+    m_diagnostics.clear();
+    m_symbolStack << m_startSymbol;
+    m_nodeStack.clear();
+    m_syntaxTree.clear();
+    m_nodeStack << (m_isSyntaxTreeEnabled ? m_syntaxTree.addNode(m_symbolStack.last()) : -1);
+    m_enteredRules.clear();
+    m_enteredRuleStackSizes.clear();
+    m_tokenIndex = 0;
+    m_usedRules.clear();
+}
+
+void SyntacticAnalyzer::addError(const Diagnostic &error)
+{
+    m_diagnostics.append(error);
+}
+
+void SyntacticAnalyzer::addSyntacticError(TokenCursor &tokenCursor)
 {
-    m_tokenToParseList = tokenList;
-    m_symbolToParseList.clear();
-    m_errorText.clear();
-    m_symbolToParseList << SyntacticSymbol ("S", SyntacticSymbol::START_SYMBOL);
-    m_usedRuleList.clear();
+    // Error message needs only first token to parse
+    QList<Token> tokenToParseList;
+    if (!tokenCursor.atEnd())
+        tokenToParseList << tokenCursor.peek();
+    QList<SyntacticSymbol> symbolToParseList;
+    if (!m_symbolStack.isEmpty())
+        symbolToParseList << m_symbolStack.last();
+    this->addError(ErrorGenerator::syntacticError(tokenToParseList, symbolToParseList));
 }
 
-void SyntacticAnalyzer::addError(QString errorText)
+void SyntacticAnalyzer::useRule(int ruleNumber)
 {
-   m_errorText += QString("%1:\t").arg(m_errorText.split("\n").count()) + errorText + "\n";
+    if (m_isTracingEnabled)
+        m_usedRules.append(ruleNumber);
 }
 
-void SyntacticAnalyzer::useRule(int number, const SyntacticSymbol &leftPart, const QList<SyntacticSymbol> &rightPart)
+void SyntacticAnalyzer::setTracingEnabled(bool isEnabled)
 {
-    m_usedRuleList << QString("№%1\t" + MakeStringRepresentation(leftPart) + " ::= " + MakeStringRepresentation(rightPart)).arg(number);
+    m_isTracingEnabled = isEnabled;
+}
+
+bool SyntacticAnalyzer::isTracingEnabled() const
+{
+    return m_isTracingEnabled;
+}
+
+const QVector<int> &SyntacticAnalyzer::usedRules() const
+{
+    return m_usedRules;
+}
+
+QString SyntacticAnalyzer::ruleText(int ruleNumber) const
+{
+    const Production &production = m_productions.at(ruleNumber);
+    const SyntacticSymbol &leftPart = m_nonterminals.at(m_productionNonterminals.at(ruleNumber));
+    return QString("№%1\t").arg(production.number() + 1)
+            + MakeStringRepresentation(leftPart) + " ::= " + MakeStringRepresentation(production.syntacticSymbolList());
 }
 
 QStringList SyntacticAnalyzer::usedRuleList() const
 {
-    return m_usedRuleList;
+    QStringList usedRuleList;
+    foreach (int ruleNumber, m_usedRules)
+        usedRuleList << this->ruleText(ruleNumber);
+    return usedRuleList;
+}
+
+const TerminalIdTable &SyntacticAnalyzer::terminalIdTable() const
+{
+    return m_terminalIdTable;
+}
+
+int SyntacticAnalyzer::ruleCount() const
+{
+    return m_productions.size();
+}
+
+QList<SyntacticSymbol> SyntacticAnalyzer::ruleRightPart(int ruleNumber) const
+{
+    return m_productions.at(ruleNumber).syntacticSymbolList();
+}
+
+int SyntacticAnalyzer::ruleNonterminal(int ruleNumber) const
+{
+    return m_productionNonterminals.at(ruleNumber);
+}
+
+int SyntacticAnalyzer::nonterminalCount() const
+{
+    return m_nonterminals.size();
+}
+
+SyntacticSymbol SyntacticAnalyzer::nonterminal(int nonterminal) const
+{
+    return m_nonterminals.at(nonterminal);
+}
+
+bool SyntacticAnalyzer::isNullableNonterminal(int nonterminal) const
+{
+    return m_nullableRules.at(nonterminal) >= 0;
+}
+
+int SyntacticAnalyzer::nullableRule(int nonterminal) const
+{
+    return m_nullableRules.at(nonterminal);
+}
+
+bool SyntacticAnalyzer::isInFirstSet(int nonterminal, int terminalId) const
+{
+    return m_firstSets.at(nonterminal).at(terminalId);
+}
+
+bool SyntacticAnalyzer::isInFollowSet(int nonterminal, int terminalId) const
+{
+    return m_followSets.at(nonterminal).at(terminalId);
+}
+
+int SyntacticAnalyzer::terminalCount() const
+{
+    return m_terminals.size();
+}
+
+SyntacticSymbol SyntacticAnalyzer::terminal(int terminalId) const
+{
+    return m_terminals.at(terminalId);
+}
+
+int SyntacticAnalyzer::tableRule(int nonterminal, int terminalId) const
+{
+    return m_parseTable.at(nonterminal * (m_terminals.size() + 1) + terminalId);
 }
 
 QString SyntacticAnalyzer::errorText() const
 {
-    return m_errorText;
+    return m_diagnostics.text();
+}
+
+const DiagnosticList &SyntacticAnalyzer::diagnostics() const
+{
+    return m_diagnostics;
+}
+
+const SyntaxTree &SyntacticAnalyzer::syntaxTree() const
+{
+    return m_syntaxTree;
+}
+
+void SyntacticAnalyzer::setSyntaxTreeEnabled(bool isEnabled)
+{
+    m_isSyntaxTreeEnabled = isEnabled;
+}
+
+bool SyntacticAnalyzer::isSyntaxTreeEnabled() const
+{
+    return m_isSyntaxTreeEnabled;
+}
+
+void SyntacticAnalyzer::setParseEventHandler(ParseEventHandler *parseEventHandler)
+{
+    m_parseEventHandler = parseEventHandler;
+}
+
+ParseEventHandler *SyntacticAnalyzer::parseEventHandler() const
+{
+    return m_parseEventHandler;
+}
+
+void SyntacticAnalyzer::setGeneratedParser(GeneratedParser generatedParser, int ruleCount, int terminalCount)
+{
+    bool isSameGrammar = (ruleCount == m_productions.size()) && (terminalCount == m_terminals.size());
+    m_generatedParser = isSameGrammar ? generatedParser : NULL;
+}
+
+bool SyntacticAnalyzer::hasGeneratedParser() const
+{
+    return (m_generatedParser != NULL) && (m_parseEventHandler == NULL);
+}
+
+void SyntacticAnalyzer::setMaxErrorCount(int maxErrorCount)
+{
+    m_maxErrorCount = maxErrorCount;
+}
+
+int SyntacticAnalyzer::maxErrorCount() const
+{
+    return m_maxErrorCount;
 }
 
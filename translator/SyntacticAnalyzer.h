@@ -11,36 +11,383 @@
 #define SYNTACTICANALYZER_H
 
 #include <QHash>
+#include <QVector>
 #include "SyntacticSymbol.h"
 #include "Token.h"
 #include "Production.h"
+#include "Diagnostic.h"
+#include "TerminalIdTable.h"
+#include "SyntaxTree.h"
+#include "ParseEventHandler.h"
+#include "GeneratedParserContext.h"
 #include <QStringList>
 
+class TokenCursor;
+class TokenStream;
+
+/*!
+ * @brief This class used to make LL(1) syntactic analysis.
+ *
+ * FIRST and FOLLOW sets of nonterminals are calculated from production rules and parse table is built,
+ * so rule for nonterminal and terminal is found by one table lookup. Rules which make grammar not LL(1)
+ * are reported when table is built. Syntax tree of source code is built by analysis. For big source code
+ * tree can be switched off and events of analysis can be handled instead, then used memory depends only on
+ * nesting depth of source code.
+ *
+ * Parser generated from the same rules can be set, then correct source code is parsed by its functions
+ * and table analysis is used only to find syntax errors.
+ *
+ * After syntax error analysis continues, so all errors are found by one pass. Tokens are skipped until
+ * line feed or token from FOLLOW set of some symbol to parse, and symbols which can't begin with it are dropped.
+ *
+ * After change of source code only subtree which contains changed tokens is parsed again. (e.g. statement
+ * or FOR ... NEXT block) Subtree of statements after change is reused when the same symbol is parsed from
+ * the same unchanged token, because LL(1) analysis from equal stack and tokens makes equal tree.
+ */
 class SyntacticAnalyzer
 {
 
+    friend class GeneratedParserContext;
+
 public:
 
+    static const int DEFAULT_MAX_ERROR_COUNT = 100;
+
+    SyntacticAnalyzer();
+
+    /*!
+     * This method used to add production rule. Terminals of rule get ids in terminal id table.
+     * Parse table must be built again after rules are added.
+     *
+     * @param[in] firstSymbol Left part of rule.
+     * @param[in] productionList Right part of rule.
+     */
     void addProductRule(const SyntacticSymbol &firstSymbol, const QList <SyntacticSymbol> &productionList);
+
+    /*!
+     * This method used to calculate FIRST and FOLLOW sets and build parse table. Conflicts of rules are stored
+     * in grammar diagnostics, first of conflicting rules is used in table. Analysis builds table if it is not built.
+     */
+    void buildParseTable();
+    bool isParseTableBuilt() const;
+
+    /*!
+     * This method used to set parse table which was built before from the same rules (e.g. by
+     * DialectTableGenerator), so FIRST and FOLLOW sets are not calculated. Tables have row for each nonterminal
+     * and column for each terminal and end of source code.
+     *
+     * @param[in] parseTable Rule of each table cell or -1.
+     * @param[in] nullableRules Rule for empty string of each nonterminal or -1.
+     * @param[in] firstSets FIRST sets.
+     * @param[in] followSets FOLLOW sets.
+     * @param[in] grammarDiagnostics Conflicts of rules which were found when table was built.
+     * @return If sizes of tables match rules returns true other returns false and table is not set.
+     */
+    bool setParseTable(const QVector<int> &parseTable,
+                       const QVector<int> &nullableRules,
+                       const QVector<bool> &firstSets,
+                       const QVector<bool> &followSets,
+                       const DiagnosticList &grammarDiagnostics);
+
+    /*!
+     * This method returns conflicts of production rules which were found when parse table was built.
+     *
+     * @return Grammar errors.
+     */
+    const DiagnosticList &grammarDiagnostics() const;
+
     void analyze(const QList<Token> &tokenList);
+
+    /*!
+     * This method used to analyze token stream. Spaces of stream are trivia, so they are not parsed.
+     *
+     * @param[in] tokenStream Stream of tokens.
+     */
+    void analyze(const TokenStream &tokenStream);
+
+    /*!
+     * This method used to analyze tokens which are read one by one. Spaces must be skipped by cursor.
+     *
+     * @param[in,out] tokenCursor Cursor of tokens.
+     */
+    void analyze(TokenCursor &tokenCursor);
+
+    /*!
+     * This method used to analyze token stream after tokens of source code part were replaced.
+     * (e.g. by LexicalAnalyzer::reanalyze) Syntax tree of last analysis of stream is updated when it has no
+     * errors and change is parsed without errors, otherwise whole stream is analyzed. Nodes of unchanged
+     * subtrees keep their indexes. When tracing is enabled only rules of parsed subtree are replaced in used rules.
+     *
+     * @param[in] tokenStream Stream of tokens after change.
+     * @param[in] beginIndex Index of first replaced token.
+     * @param[in] removedCount Count of replaced tokens before change.
+     * @param[in] addedCount Count of tokens which replaced them.
+     */
+    void reanalyze(const TokenStream &tokenStream, int beginIndex, int removedCount, int addedCount);
     QString errorText() const;
+    const DiagnosticList &diagnostics() const;
+
+    /*!
+     * This method returns syntax tree of last analysis. Tokens of tree are indexed in order of reading
+     * by cursor, spaces are not counted when they are skipped. After syntax errors tree is not complete.
+     *
+     * @return Syntax tree.
+     */
+    const SyntaxTree &syntaxTree() const;
+
+    /*!
+     * This method used to switch building of syntax tree. Tree is built by default.
+     *
+     * @param[in] isEnabled Is syntax tree built.
+     */
+    void setSyntaxTreeEnabled(bool isEnabled);
+    bool isSyntaxTreeEnabled() const;
+
+    /*!
+     * This method used to set handler of analysis events. Handler is not owned by analyzer.
+     *
+     * @param[in] parseEventHandler Handler of events or NULL.
+     */
+    void setParseEventHandler(ParseEventHandler *parseEventHandler);
+    ParseEventHandler *parseEventHandler() const;
+
+    /*!
+     * This method used to set parser which was generated from rules of analyzer. Parser is used only when
+     * counts of rules and terminals are the same and there is no handler of events. It is removed when rule is added.
+     *
+     * @param[in] generatedParser Parser function or NULL.
+     * @param[in] ruleCount Count of rules which parser was generated from.
+     * @param[in] terminalCount Count of terminals which parser was generated from.
+     */
+    void setGeneratedParser(GeneratedParser generatedParser, int ruleCount, int terminalCount);
+    bool hasGeneratedParser() const;
+
+    /*!
+     * This method used to set count of errors after which analysis is stopped.
+     *
+     * @param[in] maxErrorCount Count of errors. Zero means that count is not limited.
+     */
+    void setMaxErrorCount(int maxErrorCount);
+    int maxErrorCount() const;
 
+    /*!
+     * This method used to switch recording of used rules. Recording is on by default.
+     *
+     * @param[in] isEnabled Are used rules recorded.
+     */
+    void setTracingEnabled(bool isEnabled);
+    bool isTracingEnabled() const;
+
+    /*!
+     * This method returns numbers of rules in order of use by last analysis. Rule text is made by ruleText().
+     *
+     * @return Numbers of used rules.
+     */
+    const QVector<int> &usedRules() const;
+
+    /*!
+     * This method used to make text of rule. (e.g. "№1	S ::= <A> ")
+     *
+     * @param[in] ruleNumber Number of rule.
+     * @return Rule text.
+     */
+    QString ruleText(int ruleNumber) const;
+
+    /*!
+     * This method used to make texts of all used rules. It is slow for big programs, usedRules() is preferred.
+     *
+     * @return Texts of used rules.
+     */
     QStringList usedRuleList() const;
 
+    /*!
+     * This method returns ids of grammar terminals. Lexical analyzer must use this table to write terminal ids
+     * into token stream, otherwise terminal ids of tokens are found by lexemes.
+     *
+     * @return Terminal id table.
+     */
+    const TerminalIdTable &terminalIdTable() const;
+
+    /*!
+     * This method returns count of rules. Methods below give parse table to parser generator.
+     *
+     * @return Count of rules.
+     */
+    int ruleCount() const;
+    QList<SyntacticSymbol> ruleRightPart(int ruleNumber) const;
+    int ruleNonterminal(int ruleNumber) const;
+
+    int nonterminalCount() const;
+    SyntacticSymbol nonterminal(int nonterminal) const;
+    int nonterminalIndex(const SyntacticSymbol &symbol) const;
+    bool isNullableNonterminal(int nonterminal) const;
+    int nullableRule(int nonterminal) const;
+    bool isInFirstSet(int nonterminal, int terminalId) const;
+    bool isInFollowSet(int nonterminal, int terminalId) const;
+
+    int terminalCount() const;
+    SyntacticSymbol terminal(int terminalId) const;
+
+    /*!
+     * This method used to get rule of parse table cell.
+     *
+     * @param[in] nonterminal Index of nonterminal.
+     * @param[in] terminalId Terminal id or count of terminals for end of source code and unknown tokens.
+     * @return Number of rule or -1 if there is no rule.
+     */
+    int tableRule(int nonterminal, int terminalId) const;
+
 private:
 
-    Production findCongruentRule(const SyntacticSymbol &firstSymbol, const Token &firstProductSymbol) const;
-    Production findLambdaRule(const SyntacticSymbol &firstSymbol) const;
-    bool isLambdaRuleExists(const SyntacticSymbol &firstSymbol);
-
-    void prepareToAnalysis(const QList<Token> &tokenList);
-    void addError(QString errorText);
-    void useRule(int number, const SyntacticSymbol &leftPart, const QList<SyntacticSymbol> &rightPart);
-    QMultiHash < SyntacticSymbol, Production > m_productRules;
-    QList <SyntacticSymbol> m_symbolToParseList;
-    QList <Token> m_tokenToParseList;
-    QString m_errorText;
-    QStringList m_usedRuleList;
+    /*!
+     * This method used to parse correct source code by generated parser.
+     *
+     * @param[in,out] tokenCursor Cursor of tokens.
+     * @return If source code is parsed returns true other returns false.
+     */
+    bool analyzeByGeneratedParser(TokenCursor &tokenCursor);
+
+    /*!
+     * This method used to find rule which parses nonterminal from token.
+     *
+     * @param[in] symbol Symbol to parse.
+     * @param[in] terminalId Terminal id of token.
+     * @return Number of rule or -1 if there is no rule.
+     */
+    int findRule(const SyntacticSymbol &symbol, int terminalId) const;
+
+    /*!
+     * This method used to check can symbol be parsed from empty string.
+     *
+     * @param[in] symbol Syntactic symbol.
+     * @return If symbol is nonterminal with rule for empty string returns true other returns false.
+     */
+    bool isNullable(const SyntacticSymbol &symbol) const;
+    int addNonterminal(const SyntacticSymbol &symbol);
+
+    void calculateFirstSets();
+    void calculateFollowSets();
+
+    /*!
+     * This method used to add terminals which can begin part of rule to set.
+     *
+     * @param[in] rightPart Right part of rule.
+     * @param[in] beginIndex Index of first symbol of part.
+     * @param[out] set Set of terminals, its size is count of terminals + 1.
+     * @return If part can be parsed from empty string returns true other returns false.
+     */
+    bool addFirstSet(const QList<SyntacticSymbol> &rightPart, int beginIndex, QVector<bool> &set) const;
+
+    /*!
+     * This method used to set rule of parse table cell. Conflicts are reported.
+     *
+     * @param[in] nonterminal Index of nonterminal.
+     * @param[in] terminalId Terminal id or count of terminals for end of source code.
+     * @param[in] ruleNumber Number of rule.
+     */
+    void setTableRule(int nonterminal, int terminalId, int ruleNumber);
+    QString terminalRepresentation(int terminalId) const;
+
+    /*!
+     * This method used to push right part of rule to stack of symbols to parse. First symbol is on top.
+     *
+     * @param[in] rightPart Right part of rule.
+     * @param[in] firstNode Index of syntax tree node of first symbol, nodes of symbols follow it.
+     */
+    void pushSymbols(const QList<SyntacticSymbol> &rightPart, int firstNode);
+
+    /*!
+     * This method used to send events of entering rule. Rule is exited when stack of symbols to parse is
+     * shorter than after rule nonterminal was removed.
+     *
+     * @param[in] ruleNumber Number of rule.
+     */
+    void enterRule(int ruleNumber);
+
+    /*!
+     * This method used to send events of exiting rules.
+     *
+     * @param[in] stackSize Size of symbols stack. Rules which end at this size or above are exited.
+     */
+    void exitRules(int stackSize);
+
+    /*!
+     * This method used to make LL(1) analysis. Events of rules which are not exited are sent by analyze().
+     *
+     * @param[in,out] tokenCursor Cursor of tokens.
+     */
+    void parse(TokenCursor &tokenCursor);
+
+    /*!
+     * This method used to parse again subtree which contains changed tokens and tokens around them,
+     * so rules outside of subtree are used as before. Tree is broken when parsing fails.
+     *
+     * @param[in] tokenStream Stream of tokens after change.
+     * @param[in] beginIndex Index of first replaced token.
+     * @param[in] removedCount Count of replaced tokens before change.
+     * @param[in] addedCount Count of tokens which replaced them.
+     * @return If subtree is parsed without errors returns true other returns false.
+     */
+    bool reparse(const TokenStream &tokenStream, int beginIndex, int removedCount, int addedCount);
+
+    /*!
+     * This method used to skip token which is read by cursor.
+     *
+     * @param[in,out] tokenCursor Cursor of tokens.
+     */
+    void skipToken(TokenCursor &tokenCursor);
+
+    /*!
+     * This method used to check can symbol be parsed from string which begins with terminal.
+     *
+     * @param[in] symbol Syntactic symbol.
+     * @param[in] terminalId Terminal id.
+     * @return If terminal is symbol or it is in FIRST set of symbol returns true other returns false.
+     */
+    bool canBeginWith(const SyntacticSymbol &symbol, int terminalId) const;
+
+    /*!
+     * This method used to continue analysis after syntax error. Tokens are skipped until synchronizing token
+     * which some symbol to parse can begin with, symbols above this symbol are removed from stack.
+     * Synchronizing tokens are line feeds and terminals of FOLLOW sets of symbols to parse. (e.g. "END", "NEXT")
+     *
+     * @param[in,out] tokenCursor Cursor of tokens.
+     */
+    void recoverFromError(TokenCursor &tokenCursor);
+
+    void prepareToAnalysis();
+    void addError(const Diagnostic &error);
+    void addSyntacticError(TokenCursor &tokenCursor);
+    void useRule(int ruleNumber);
+    QVector<Production> m_productions;
+    QVector<int> m_productionNonterminals;
+    QList <SyntacticSymbol> m_nonterminals;
+    QVector<int> m_nonterminalIndexes;
+    QVector<SyntacticSymbol> m_terminals;
+    QVector<QVector<bool> > m_firstSets;
+    QVector<QVector<bool> > m_followSets;
+    QVector<bool> m_nullableNonterminals;
+    QVector<int> m_nullableRules;
+    QVector<int> m_parseTable;
+    bool m_isParseTableBuilt;
+    DiagnosticList m_grammarDiagnostics;
+    QVector<SyntacticSymbol> m_symbolStack;
+    QVector<int> m_nodeStack;
+    SyntaxTree m_syntaxTree;
+    bool m_isSyntaxTreeEnabled;
+    bool m_isTokenStreamAnalyzed;
+    int m_analyzedTreeSize;
+    ParseEventHandler *m_parseEventHandler;
+    GeneratedParser m_generatedParser;
+    QVector<int> m_enteredRules;
+    QVector<int> m_enteredRuleStackSizes;
+    int m_tokenIndex;
+    DiagnosticList m_diagnostics;
+    int m_maxErrorCount;
+    QVector<int> m_usedRules;
+    bool m_isTracingEnabled;
+    TerminalIdTable m_terminalIdTable;
+    SyntacticSymbol m_startSymbol;      //!< Start symbol, it is interned once to make no lock of symbol table while parsing.
 
 };
 
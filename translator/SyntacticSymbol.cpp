@@ -1,37 +1,64 @@
 #include "SyntacticSymbol.h"
 #include <QHash>
 
-QHash <QString, SyntacticSymbol::SyntacticSymbolType> SyntacticSymbol::m_convertingStringToSyntacticSymbolTypeHash;
+QHash <QString, int> SyntacticSymbol::m_symbolIds;
+QVector<QString> SyntacticSymbol::m_symbolNames;
+QReadWriteLock SyntacticSymbol::m_symbolTableLock;
+
+static QHash<QString, SyntacticSymbol::SyntacticSymbolType> MakeSyntacticSymbolTypeHash()
+{
+    QHash<QString, SyntacticSymbol::SyntacticSymbolType> syntacticSymbolTypeHash;
+    syntacticSymbolTypeHash.insert("nonterminalSymbol", SyntacticSymbol::NONTERMINAL_SYMBOL);
+    syntacticSymbolTypeHash.insert("startSymbol",       SyntacticSymbol::START_SYMBOL);
+    syntacticSymbolTypeHash.insert("terminalSymbol",    SyntacticSymbol::TERMINAL_SYMBOL);
+    return syntacticSymbolTypeHash;
+}
+
+SyntacticSymbol::SyntacticSymbol() :
+    m_id(-1),
+    m_type(SyntacticSymbol::NONTERMINAL_SYMBOL),
+    m_category(Token::NONE_CATEGORY),
+    m_terminalId(TerminalIdTable::UNKNOWN_TERMINAL)
+{}
 
 SyntacticSymbol::SyntacticSymbol(const QString &name, SyntacticSymbol::SyntacticSymbolType type, Token::TokenCategory category) :
-    m_name(name),
+    m_id(SyntacticSymbol::InternSymbol(name, type)),
     m_type(type),
-    m_category(category)
+    m_category(category),
+    m_terminalId(TerminalIdTable::UNKNOWN_TERMINAL)
 {}
 
 SyntacticSymbol::SyntacticSymbol(const QString &name, const QString &type, const QString &category) :
-    m_name(name),
+    m_id(SyntacticSymbol::InternSymbol(name, SyntacticSymbol::stringToSyntacticSymbolType(type))),
     m_type(SyntacticSymbol::stringToSyntacticSymbolType(type)),
-    m_category(Token::stringToTokenCategory(category))
+    m_category(Token::stringToTokenCategory(category)),
+    m_terminalId(TerminalIdTable::UNKNOWN_TERMINAL)
 {}
 
 QString SyntacticSymbol::name() const
 {
-    return m_name;
+    if (m_id < 0)
+        return QString();
+    QReadLocker locker(&m_symbolTableLock);
+    return m_symbolNames.at(m_id);
 }
 
 void SyntacticSymbol::setName(const QString &name)
 {
-    m_name = name;
+    // Type of incorrect symbol is kept in m_type only, so it is not taken from type()
+    m_id = SyntacticSymbol::InternSymbol(name, m_type);
 }
 
 SyntacticSymbol::SyntacticSymbolType SyntacticSymbol::type() const
 {
+    if (m_id < 0)
+        return SyntacticSymbol::NONTERMINAL_SYMBOL;
     return m_type;
 }
 
 void SyntacticSymbol::setType(const SyntacticSymbolType &type)
 {
+    m_id = SyntacticSymbol::InternSymbol(this->name(), type);
     m_type = type;
 }
 
@@ -45,34 +72,73 @@ void SyntacticSymbol::setCategory(const Token::TokenCategory &category)
     m_category = category;
 }
 
-SyntacticSymbol::SyntacticSymbolType SyntacticSymbol::stringToSyntacticSymbolType(const QString &string)
+int SyntacticSymbol::terminalId() const
 {
-    if (m_convertingStringToSyntacticSymbolTypeHash.isEmpty()) {
-        m_convertingStringToSyntacticSymbolTypeHash.insert("nonterminalSymbol", SyntacticSymbol::NONTERMINAL_SYMBOL);
-        m_convertingStringToSyntacticSymbolTypeHash.insert("startSymbol",       SyntacticSymbol::START_SYMBOL);
-        m_convertingStringToSyntacticSymbolTypeHash.insert("terminalSymbol",    SyntacticSymbol::TERMINAL_SYMBOL);
-    }
+    return m_terminalId;
+}
 
-    return m_convertingStringToSyntacticSymbolTypeHash.value(string);
+void SyntacticSymbol::setTerminalId(int terminalId)
+{
+    m_terminalId = terminalId;
+}
+
+SyntacticSymbol::SyntacticSymbolType SyntacticSymbol::stringToSyntacticSymbolType(const QString &string)
+{
+    // Hash is made once by thread-safe static initialization and it is only read after it, so it needs no lock
+    static const QHash<QString, SyntacticSymbolType> syntacticSymbolTypeHash = MakeSyntacticSymbolTypeHash();
+    return syntacticSymbolTypeHash.value(string);
 }
 
 bool SyntacticSymbol::isCorrect() const
 {
-    if(m_name.isNull())
-        return false;
-    return true;
+    return m_id >= 0;
+}
+
+int SyntacticSymbol::id() const
+{
+    return m_id;
+}
+
+int SyntacticSymbol::SymbolCount()
+{
+    QReadLocker locker(&m_symbolTableLock);
+    return m_symbolNames.size();
+}
+
+int SyntacticSymbol::InternSymbol(const QString &name, SyntacticSymbolType type)
+{
+    // Incorrect symbols have no name, all start symbols are one symbol
+    if (name.isNull() && (type != SyntacticSymbol::START_SYMBOL))
+        return -1;
+    QString key = QString::number(type) + ":";
+    if (type != SyntacticSymbol::START_SYMBOL)
+        key += name;
+
+    // Symbols are usually already in table, so table is locked for writing only to add symbol
+    {
+        QReadLocker locker(&m_symbolTableLock);
+        int id = m_symbolIds.value(key, -1);
+        if (id >= 0)
+            return id;
+    }
+    QWriteLocker locker(&m_symbolTableLock);
+    int id = m_symbolIds.value(key, -1);
+    if (id < 0) {
+        id = m_symbolNames.size();
+        m_symbolIds.insert(key, id);
+        m_symbolNames.append(name);
+    }
+    return id;
 }
 
 bool operator==(const SyntacticSymbol &symbol1, const SyntacticSymbol &symbol2)
 {
-    bool areSymbolsTypeStart = (symbol1.type() == SyntacticSymbol::START_SYMBOL)&&(symbol2.type() == SyntacticSymbol::START_SYMBOL);
-    bool areSymbolsSame = (symbol1.name() == symbol2.name())&&(symbol1.type() == symbol2.type());
-    return (areSymbolsSame || areSymbolsTypeStart);
+    return symbol1.id() == symbol2.id();
 }
 
 uint qHash(const SyntacticSymbol &symbol)
 {
-    return qHash(symbol.name());
+    return qHash(symbol.id());
 }
 
 bool operator==(const Token &token, const SyntacticSymbol &symbol)
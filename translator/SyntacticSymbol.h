@@ -11,8 +11,20 @@
 #define SYNTACTICSYMBOL_H
 
 #include <QString>
+#include <QVector>
+#include <QHash>
+#include <QReadWriteLock>
 #include "Token.h"
+#include "TerminalIdTable.h"
 
+/*!
+ * @brief This class used to represent symbol of grammar.
+ *
+ * Names of symbols are interned in symbol table when symbols are made (e.g. by BackusNaurFormParser), so symbol
+ * is stored as integer id and symbols are compared and hashed by ids. Name is taken from table only for messages.
+ * All start symbols have the same id. Symbol table is shared by all analyzers and it is guarded by lock, so
+ * symbols can be made and read by several threads.
+ */
 class SyntacticSymbol
 {
 
@@ -24,7 +36,7 @@ public:
         TERMINAL_SYMBOL      = 2
     };
 
-    SyntacticSymbol(){}
+    SyntacticSymbol();
     SyntacticSymbol(const QString &name, SyntacticSymbolType type, Token::TokenCategory category = Token::NONE_CATEGORY);
     SyntacticSymbol(const QString &name, const QString &type, const QString &category);
 
@@ -37,20 +49,56 @@ public:
     Token::TokenCategory category() const;
     void setCategory(const Token::TokenCategory &category);
 
+    /*!
+     * This method returns id of symbol in symbol table.
+     *
+     * @return Id from 0 to SymbolCount() - 1 or -1 for incorrect symbol.
+     */
+    int id() const;
+    static int SymbolCount();
+
+    /*!
+     * This method returns id of terminal symbol in terminal id table of syntactic analyzer.
+     *
+     * @return Terminal id or UNKNOWN_TERMINAL for nonterminal symbols.
+     */
+    int terminalId() const;
+    void setTerminalId(int terminalId);
+
     static SyntacticSymbolType stringToSyntacticSymbolType(const QString &string);
 
     bool isCorrect() const;
 
 private:
 
-    QString m_name;
-    SyntacticSymbolType m_type;
-    Token::TokenCategory m_category;
+    /*!
+     * This method used to find symbol in symbol table. Symbol is added if there is no such symbol.
+     *
+     * @param[in] name Name of symbol.
+     * @param[in] type Type of symbol.
+     * @return Id of symbol.
+     */
+    static int InternSymbol(const QString &name, SyntacticSymbolType type);
 
-    static QHash <QString, SyntacticSymbolType> m_convertingStringToSyntacticSymbolTypeHash;
+    int m_id;                           //!< Id of symbol in symbol table.
+    SyntacticSymbolType m_type;         //!< Type of symbol, it is kept in symbol to read it without lock.
+    Token::TokenCategory m_category;    //!< Token category of terminal symbol.
+    int m_terminalId;                   //!< Id of terminal symbol in terminal id table.
+
+    static QHash <QString, int> m_symbolIds;                //!< Id of each symbol by type and name.
+    static QVector<QString> m_symbolNames;                  //!< Name of each symbol.
+    static QReadWriteLock m_symbolTableLock;                //!< Lock of symbol table.
 
 };
 
+/*!
+ * This function used to compare symbols by ids, so symbols with the same type and name are equal even if their
+ * categories or terminal ids differ. All incorrect symbols are equal.
+ *
+ * @param[in] symbol1 First symbol.
+ * @param[in] symbol2 Second symbol.
+ * @return Are symbols equal.
+ */
 bool operator==(const SyntacticSymbol &symbol1,const SyntacticSymbol &symbol2);
 bool operator==(const Token &token,const SyntacticSymbol &symbol);
 bool operator==(const SyntacticSymbol &symbol,const Token &token);
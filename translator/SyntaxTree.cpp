@@ -0,0 +1,295 @@
+#include "SyntaxTree.h"
+#include <QSet>
+
+SyntaxTree::SyntaxTree() :
+    m_nodeCount(0),
+    m_replacementNodeCount(0),
+    m_nextUsedRuleIndex(0)
+{}
+
+void SyntaxTree::clear()
+{
+    m_nodeCount = 0;
+    m_tokenNodes.clear();
+    m_shifts.clear();
+    m_replacementNodeCount = 0;
+    m_nextUsedRuleIndex = 0;
+}
+
+bool SyntaxTree::isEmpty() const
+{
+    return m_nodeCount == 0;
+}
+
+int SyntaxTree::size() const
+{
+    return m_nodeCount;
+}
+
+int SyntaxTree::root() const
+{
+    return this->isEmpty() ? -1 : 0;
+}
+
+int SyntaxTree::addNode(const SyntacticSymbol &symbol)
+{
+    int node = this->addChildren(-1, -1, QList<SyntacticSymbol>() << symbol);
+    m_nodes[node].parent = -1;
+    return node;
+}
+
+int SyntaxTree::addChildren(int node, int ruleNumber, const QList<SyntacticSymbol> &rightPart)
+{
+    int firstChild = m_nodeCount;
+    m_nodeCount += rightPart.size();
+    if (m_nodeCount > m_nodes.size())
+        m_nodes.resize(qMax(m_nodeCount, m_nodes.size() * 2));
+
+    for (int i = 0; i < rightPart.size(); i++) {
+        SyntaxTreeNode &childNode = m_nodes[firstChild + i];
+        childNode.symbolId = rightPart.at(i).id();
+        childNode.ruleNumber = -1;
+        childNode.usedRuleIndex = -1;
+        childNode.tokenIndex = -1;
+        childNode.parent = node;
+        childNode.firstChild = m_nodeCount;
+        childNode.childCount = 0;
+        childNode.shiftCount = m_shifts.size();
+    }
+    if (node >= 0) {
+        // Rules are used in order of nodes from root, so index of rule is count of rules used before it
+        SyntaxTreeNode &parentNode = m_nodes[node];
+        parentNode.ruleNumber = ruleNumber;
+        parentNode.usedRuleIndex = m_nextUsedRuleIndex++;
+        parentNode.firstChild = firstChild;
+        parentNode.childCount = rightPart.size();
+        parentNode.shiftCount = m_shifts.size();
+    }
+    return firstChild;
+}
+
+void SyntaxTree::setTokenIndex(int node, int tokenIndex)
+{
+    m_nodes[node].tokenIndex = tokenIndex;
+    m_nodes[node].shiftCount = m_shifts.size();
+    if (tokenIndex >= m_tokenNodes.size())
+        m_tokenNodes.resize(tokenIndex + 1);
+    m_tokenNodes[tokenIndex] = node;
+}
+
+void SyntaxTree::moveSubtree(int node, int targetNode)
+{
+    const SyntaxTreeNode subtreeRoot = this->shiftedNode(node);
+    SyntaxTreeNode &targetRoot = m_nodes[targetNode];
+    targetRoot.symbolId = subtreeRoot.symbolId;
+    targetRoot.ruleNumber = subtreeRoot.ruleNumber;
+    targetRoot.usedRuleIndex = m_nextUsedRuleIndex;
+    targetRoot.tokenIndex = -1;
+    targetRoot.firstChild = subtreeRoot.firstChild;
+    targetRoot.childCount = subtreeRoot.childCount;
+    targetRoot.shiftCount = m_shifts.size();
+    for (int i = 0; i < subtreeRoot.childCount; i++)
+        m_nodes[subtreeRoot.firstChild + i].parent = targetNode;
+}
+
+void SyntaxTree::beginReplacement(int node, int beginIndex, int removedCount, int addedCount)
+{
+    m_tokenNodes.remove(beginIndex, removedCount);
+    m_tokenNodes.insert(beginIndex, addedCount, -1);
+    m_replacementNodeCount = m_nodeCount;
+    m_nextUsedRuleIndex = this->usedRuleIndex(node);
+}
+
+void SyntaxTree::endReplacement(int tokenBeginIndex, int tokenDelta, int ruleBeginIndex, int ruleDelta)
+{
+    if ((tokenDelta == 0) && (ruleDelta == 0))
+        return;
+
+    PositionShift shift;
+    shift.nodeCount = m_replacementNodeCount;
+    shift.tokenBeginIndex = tokenBeginIndex;
+    shift.tokenDelta = tokenDelta;
+    shift.ruleBeginIndex = ruleBeginIndex;
+    shift.ruleDelta = ruleDelta;
+    m_shifts.append(shift);
+
+    // Node which was not read for long time would apply many shifts
+    if (m_shifts.size() >= MAX_SHIFT_COUNT)
+        this->applyPositionShifts();
+}
+
+int SyntaxTree::nextUsedRuleIndex() const
+{
+    return m_nextUsedRuleIndex;
+}
+
+const SyntaxTreeNode &SyntaxTree::shiftedNode(int node) const
+{
+    SyntaxTreeNode &currentNode = m_nodes[node];
+    for (; currentNode.shiftCount < m_shifts.size(); currentNode.shiftCount++) {
+        const PositionShift &shift = m_shifts.at(currentNode.shiftCount);
+        if (node >= shift.nodeCount)
+            continue;
+        if (currentNode.tokenIndex >= shift.tokenBeginIndex)
+            currentNode.tokenIndex += shift.tokenDelta;
+        if (currentNode.usedRuleIndex >= shift.ruleBeginIndex)
+            currentNode.usedRuleIndex += shift.ruleDelta;
+    }
+    return currentNode;
+}
+
+void SyntaxTree::applyPositionShifts() const
+{
+    if (this->isEmpty()) {
+        m_shifts.clear();
+        return;
+    }
+
+    // Nodes of tokens are known by token indexes, rules are counted in order of use
+    SyntaxTreeNode *nodes = m_nodes.data();
+    for (int tokenIndex = 0; tokenIndex < m_tokenNodes.size(); tokenIndex++) {
+        if (m_tokenNodes.at(tokenIndex) >= 0)
+            nodes[m_tokenNodes.at(tokenIndex)].tokenIndex = tokenIndex;
+    }
+    int usedRuleIndex = 0;
+    QVector<int> nodeStack;
+    nodeStack.append(this->root());
+    while (!nodeStack.isEmpty()) {
+        SyntaxTreeNode &currentNode = nodes[nodeStack.last()];
+        nodeStack.removeLast();
+        if (currentNode.ruleNumber >= 0)
+            currentNode.usedRuleIndex = usedRuleIndex++;
+        currentNode.shiftCount = 0;
+        for (int i = currentNode.childCount - 1; i >= 0; i--)
+            nodeStack.append(currentNode.firstChild + i);
+    }
+    m_shifts.clear();
+}
+
+int SyntaxTree::symbolId(int node) const
+{
+    return m_nodes.at(node).symbolId;
+}
+
+int SyntaxTree::ruleNumber(int node) const
+{
+    return m_nodes.at(node).ruleNumber;
+}
+
+int SyntaxTree::usedRuleIndex(int node) const
+{
+    return this->shiftedNode(node).usedRuleIndex;
+}
+
+int SyntaxTree::tokenIndex(int node) const
+{
+    return this->shiftedNode(node).tokenIndex;
+}
+
+int SyntaxTree::parent(int node) const
+{
+    return m_nodes.at(node).parent;
+}
+
+int SyntaxTree::childCount(int node) const
+{
+    return m_nodes.at(node).childCount;
+}
+
+int SyntaxTree::child(int node, int position) const
+{
+    return m_nodes.at(node).firstChild + position;
+}
+
+int SyntaxTree::childPosition(int node) const
+{
+    int parent = m_nodes.at(node).parent;
+    if (parent < 0)
+        return -1;
+    return node - m_nodes.at(parent).firstChild;
+}
+
+bool SyntaxTree::isToken(int node) const
+{
+    return m_nodes.at(node).tokenIndex >= 0;
+}
+
+int SyntaxTree::tokenNode(int tokenIndex) const
+{
+    return m_tokenNodes.value(tokenIndex, -1);
+}
+
+int SyntaxTree::commonAncestor(int node, int otherNode) const
+{
+    // Node which is reached second time is reached by both climbs, lower common nodes are reached earlier
+    QSet<int> reachedNodes;
+    int climbedNodes[2] = {node, otherNode};
+    for (int i = 0; (climbedNodes[0] >= 0) || (climbedNodes[1] >= 0); i = 1 - i) {
+        int &climbedNode = climbedNodes[i];
+        if (climbedNode < 0)
+            continue;
+        if (reachedNodes.contains(climbedNode))
+            return climbedNode;
+        reachedNodes.insert(climbedNode);
+        climbedNode = m_nodes.at(climbedNode).parent;
+    }
+    return -1;
+}
+
+int SyntaxTree::firstTokenIndex(int node) const
+{
+    QVector<int> nodeStack;
+    nodeStack.append(node);
+    while (!nodeStack.isEmpty()) {
+        const SyntaxTreeNode &currentNode = this->shiftedNode(nodeStack.last());
+        if (currentNode.tokenIndex >= 0)
+            return currentNode.tokenIndex;
+        nodeStack.removeLast();
+        for (int i = currentNode.childCount - 1; i >= 0; i--)
+            nodeStack.append(currentNode.firstChild + i);
+    }
+    return -1;
+}
+
+int SyntaxTree::lastTokenIndex(int node) const
+{
+    QVector<int> nodeStack;
+    nodeStack.append(node);
+    while (!nodeStack.isEmpty()) {
+        const SyntaxTreeNode &currentNode = this->shiftedNode(nodeStack.last());
+        if (currentNode.tokenIndex >= 0)
+            return currentNode.tokenIndex;
+        nodeStack.removeLast();
+        for (int i = 0; i < currentNode.childCount; i++)
+            nodeStack.append(currentNode.firstChild + i);
+    }
+    return -1;
+}
+
+void SyntaxTree::appendTokenNodes(int node, QVector<int> &tokenNodes) const
+{
+    QVector<int> nodeStack;
+    nodeStack.append(node);
+    while (!nodeStack.isEmpty()) {
+        const SyntaxTreeNode &currentNode = m_nodes.at(nodeStack.last());
+        if (currentNode.tokenIndex >= 0)
+            tokenNodes.append(nodeStack.last());
+        nodeStack.removeLast();
+        for (int i = currentNode.childCount - 1; i >= 0; i--)
+            nodeStack.append(currentNode.firstChild + i);
+    }
+}
+
+void SyntaxTree::appendRuleNumbers(int node, QVector<int> &ruleNumbers) const
+{
+    QVector<int> nodeStack;
+    nodeStack.append(node);
+    while (!nodeStack.isEmpty()) {
+        const SyntaxTreeNode &currentNode = m_nodes.at(nodeStack.last());
+        if (currentNode.ruleNumber >= 0)
+            ruleNumbers.append(currentNode.ruleNumber);
+        nodeStack.removeLast();
+        for (int i = currentNode.childCount - 1; i >= 0; i--)
+            nodeStack.append(currentNode.firstChild + i);
+    }
+}
@@ -0,0 +1,218 @@
+#ifndef SYNTAXTREE_H
+#define SYNTAXTREE_H
+
+#include <QList>
+#include <QVector>
+#include "SyntacticSymbol.h"
+
+/*!
+ * @brief This struct used to store node of syntax tree.
+ */
+struct SyntaxTreeNode
+{
+    int symbolId;       //!< Interned id of syntactic symbol.
+    int ruleNumber;     //!< Number of rule which was used to parse nonterminal or -1.
+    int usedRuleIndex;  //!< Index of rule in rules used by analysis or -1.
+    int tokenIndex;     //!< Index of token which was parsed as terminal or -1.
+    int parent;         //!< Index of parent node or -1 for root.
+    int firstChild;     //!< Index of first child node.
+    int childCount;     //!< Count of child nodes.
+    int shiftCount;     //!< Count of position shifts which were applied to node.
+};
+
+/*!
+ * @brief This class used to store concrete syntax tree which is built by syntactic analyzer.
+ *
+ * Nodes are allocated one after another in arena, children of nonterminal are allocated together when rule
+ * is used, so they are stored in range of indexes. Nodes refer to tokens and other nodes by indexes only.
+ * Clearing of tree keeps memory of arena for next analysis.
+ *
+ * When part of source code is parsed again, new children of subtree are allocated and old nodes which are
+ * not reused stay in arena unreachable from root, so tree is walked only from root. Token indexes and rule
+ * indexes of old nodes after parsed part are not rewritten, shift of positions is recorded once and applied
+ * to node when node is read. So reading methods change nodes and tree can't be read by several threads.
+ */
+class SyntaxTree
+{
+
+public:
+
+    SyntaxTree();
+
+    void clear();
+    bool isEmpty() const;
+    int size() const;
+
+    /*!
+     * This method returns root node. Root is start symbol of grammar.
+     *
+     * @return Index of root node or -1 if tree is empty.
+     */
+    int root() const;
+
+    /*!
+     * This method used to allocate node without parent.
+     *
+     * @param[in] symbol Syntactic symbol of node.
+     * @return Index of node.
+     */
+    int addNode(const SyntacticSymbol &symbol);
+
+    /*!
+     * This method used to allocate children of nonterminal node.
+     *
+     * @param[in] node Index of nonterminal node.
+     * @param[in] ruleNumber Number of rule which was used to parse nonterminal.
+     * @param[in] rightPart Right part of rule.
+     * @return Index of first child.
+     */
+    int addChildren(int node, int ruleNumber, const QList<SyntacticSymbol> &rightPart);
+    void setTokenIndex(int node, int tokenIndex);
+
+    /*!
+     * This method used to put subtree in place of other node while subtree is replaced. Only root of subtree
+     * is copied to this node, other nodes of subtree keep their indexes. Rules of subtree follow rules which
+     * were used before it.
+     *
+     * @param[in] node Index of nonterminal subtree root.
+     * @param[in] targetNode Index of node which is replaced. Its parent is kept.
+     */
+    void moveSubtree(int node, int targetNode);
+
+    /*!
+     * This method used to begin replacement of subtree after tokens of source code part were replaced.
+     * Replaced tokens have no nodes until setTokenIndex() is called for them, rules used by new children
+     * get indexes from first rule of subtree.
+     *
+     * @param[in] node Index of subtree root.
+     * @param[in] beginIndex Index of first replaced token.
+     * @param[in] removedCount Count of tokens before change.
+     * @param[in] addedCount Count of tokens after change.
+     */
+    void beginReplacement(int node, int beginIndex, int removedCount, int addedCount);
+
+    /*!
+     * This method used to end replacement of subtree. Positions of old nodes after replaced part are moved
+     * when nodes are read, nodes allocated by replacement already have new positions.
+     *
+     * @param[in] tokenBeginIndex Index of first old token after replaced part before change.
+     * @param[in] tokenDelta Difference of token count.
+     * @param[in] ruleBeginIndex Index of first old rule after replaced part before change.
+     * @param[in] ruleDelta Difference of rule count.
+     */
+    void endReplacement(int tokenBeginIndex, int tokenDelta, int ruleBeginIndex, int ruleDelta);
+
+    /*!
+     * This method returns index of rule which is used next. After replacement it is index after rules
+     * of replaced part.
+     *
+     * @return Index of rule.
+     */
+    int nextUsedRuleIndex() const;
+
+    int symbolId(int node) const;
+    int ruleNumber(int node) const;
+    int usedRuleIndex(int node) const;
+    int tokenIndex(int node) const;
+    int parent(int node) const;
+    int childCount(int node) const;
+    int child(int node, int position) const;
+
+    /*!
+     * This method used to get position of node in children of its parent.
+     *
+     * @param[in] node Index of node.
+     * @return Position of node or -1 for root.
+     */
+    int childPosition(int node) const;
+
+    /*!
+     * This method used to check is node parsed terminal.
+     *
+     * @param[in] node Index of node.
+     * @return If node has token returns true other returns false.
+     */
+    bool isToken(int node) const;
+
+    /*!
+     * This method used to find node which parsed token.
+     *
+     * @param[in] tokenIndex Index of token.
+     * @return Index of node or -1 if token was not parsed.
+     */
+    int tokenNode(int tokenIndex) const;
+
+    /*!
+     * This method used to find lowest node which contains both nodes. Nodes are climbed in turn,
+     * so time depends on distance to common ancestor, not on depth of tree.
+     *
+     * @param[in] node Index of first node.
+     * @param[in] otherNode Index of second node.
+     * @return Index of common ancestor or -1 if nodes are in different trees.
+     */
+    int commonAncestor(int node, int otherNode) const;
+
+    /*!
+     * This method used to find first token of subtree.
+     *
+     * @param[in] node Index of subtree root.
+     * @return Index of token or -1 if subtree has no tokens.
+     */
+    int firstTokenIndex(int node) const;
+    int lastTokenIndex(int node) const;
+
+    /*!
+     * This method used to get tokens of subtree. Nodes are visited without recursion, so tree depth is not limited.
+     *
+     * @param[in] node Index of subtree root.
+     * @param[out] tokenNodes Nodes with tokens in order of tokens.
+     */
+    void appendTokenNodes(int node, QVector<int> &tokenNodes) const;
+
+    /*!
+     * This method used to get rules of subtree in order of use by analysis.
+     *
+     * @param[in] node Index of subtree root.
+     * @param[out] ruleNumbers Numbers of rules.
+     */
+    void appendRuleNumbers(int node, QVector<int> &ruleNumbers) const;
+
+private:
+
+    /*!
+     * @brief This struct used to store shift of positions after replacement of subtree.
+     */
+    struct PositionShift
+    {
+        int nodeCount;          //!< Count of nodes allocated before replacement, only they are moved.
+        int tokenBeginIndex;    //!< Index of first moved token before replacement.
+        int tokenDelta;         //!< Difference of token indexes.
+        int ruleBeginIndex;     //!< Index of first moved rule before replacement.
+        int ruleDelta;          //!< Difference of rule indexes.
+    };
+
+    /*!
+     * This method used to apply shifts which were recorded after last read of node.
+     *
+     * @param[in] node Index of node.
+     * @return Node with current positions.
+     */
+    const SyntaxTreeNode &shiftedNode(int node) const;
+
+    /*!
+     * This method used to write current positions to all nodes reachable from root and forget shifts.
+     */
+    void applyPositionShifts() const;
+
+    mutable QVector<SyntaxTreeNode> m_nodes;    //!< Arena of nodes.
+    int m_nodeCount;                            //!< Count of allocated nodes.
+    QVector<int> m_tokenNodes;                  //!< Node of each parsed token.
+    mutable QVector<PositionShift> m_shifts;    //!< Shifts of positions which are not written to all nodes.
+    int m_replacementNodeCount;                 //!< Count of nodes allocated before current replacement.
+    int m_nextUsedRuleIndex;                    //!< Index of rule which is used next.
+
+    static const int MAX_SHIFT_COUNT = 32;      //!< Maximum count of shifts which are applied when node is read.
+
+};
+
+#endif // SYNTAXTREE_H
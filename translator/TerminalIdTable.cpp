@@ -0,0 +1,75 @@
+#include "TerminalIdTable.h"
+
+static const int TOKEN_CATEGORY_COUNT = Token::STRING_LITERAL_CATEGORY + 1;
+
+const int TerminalIdTable::UNKNOWN_TERMINAL;
+
+TerminalIdTable::TerminalIdTable() :
+    m_size(0)
+{
+    m_categoryTerminalIds.fill(UNKNOWN_TERMINAL, TOKEN_CATEGORY_COUNT);
+}
+
+void TerminalIdTable::clear()
+{
+    m_categoryTerminalIds.fill(UNKNOWN_TERMINAL, TOKEN_CATEGORY_COUNT);
+    m_lexemeTerminalIds.clear();
+    m_size = 0;
+}
+
+int TerminalIdTable::addTerminal(Token::TokenCategory category, const QString &lexeme)
+{
+    int id = this->terminalId(category, lexeme);
+    if (id != UNKNOWN_TERMINAL)
+        return id;
+
+    id = m_size++;
+    if (IsCategoryTerminal(category))
+        m_categoryTerminalIds[category] = id;
+    else
+        m_lexemeTerminalIds.insert(lexeme, id);
+    return id;
+}
+
+int TerminalIdTable::terminalId(Token::TokenCategory category, const QString &lexeme) const
+{
+    if (IsCategoryTerminal(category))
+        return m_categoryTerminalIds.at(category);
+    return m_lexemeTerminalIds.value(lexeme, UNKNOWN_TERMINAL);
+}
+
+int TerminalIdTable::size() const
+{
+    return m_size;
+}
+
+bool TerminalIdTable::isEmpty() const
+{
+    return m_size == 0;
+}
+
+bool TerminalIdTable::operator==(const TerminalIdTable &other) const
+{
+    // Copies of one table share data, so they are compared without hash lookups
+    return (m_size == other.m_size)
+            && (m_categoryTerminalIds == other.m_categoryTerminalIds)
+            && (m_lexemeTerminalIds == other.m_lexemeTerminalIds);
+}
+
+bool TerminalIdTable::operator!=(const TerminalIdTable &other) const
+{
+    return !(*this == other);
+}
+
+bool TerminalIdTable::IsCategoryTerminal(Token::TokenCategory category)
+{
+    switch (category) {
+    case Token::IDENTIFIER_CATEGORY:
+    case Token::NUMBER_LITERAL_CATEGORY:
+    case Token::STRING_LITERAL_CATEGORY:
+    case Token::LINE_FEED_CATEGORY:
+        return true;
+    default:
+        return false;
+    }
+}
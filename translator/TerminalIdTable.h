@@ -0,0 +1,72 @@
+#ifndef TERMINALIDTABLE_H
+#define TERMINALIDTABLE_H
+
+#include <QString>
+#include <QHash>
+#include <QVector>
+#include "Token.h"
+
+/*!
+ * @brief This class used to number terminal symbols of grammar.
+ *
+ * Identifiers, number literals, string literals and line feeds are terminals by token category, keywords
+ * and character tokens are terminals by lexeme. Lexical analyzer writes terminal id of every token into
+ * token stream, so syntactic analyzer matches tokens with terminals by integer comparison.
+ */
+class TerminalIdTable
+{
+
+public:
+
+    static const int UNKNOWN_TERMINAL = -1;    //!< Id of token which is not terminal of grammar.
+
+    TerminalIdTable();
+
+    void clear();
+
+    /*!
+     * This method used to add terminal. Terminal which is already added keeps its id.
+     *
+     * @param[in] category Token category of terminal.
+     * @param[in] lexeme Lexeme of keyword or character token, other terminals are added by category.
+     * @return Id of terminal.
+     */
+    int addTerminal(Token::TokenCategory category, const QString &lexeme);
+
+    /*!
+     * This method used to find terminal of token.
+     *
+     * @param[in] category Token category.
+     * @param[in] lexeme Token lexeme. It is used only for categories which are not terminals by themselves.
+     * @return Id of terminal or UNKNOWN_TERMINAL.
+     */
+    int terminalId(Token::TokenCategory category, const QString &lexeme) const;
+
+    /*!
+     * This method returns count of terminals. Ids are from 0 to size - 1.
+     *
+     * @return Count of terminals.
+     */
+    int size() const;
+    bool isEmpty() const;
+
+    bool operator==(const TerminalIdTable &other) const;
+    bool operator!=(const TerminalIdTable &other) const;
+
+    /*!
+     * This method used to check is token category terminal by itself. (e.g. every identifier is "id" terminal)
+     *
+     * @param[in] category Token category.
+     * @return If all tokens of category are one terminal returns true other returns false.
+     */
+    static bool IsCategoryTerminal(Token::TokenCategory category);
+
+private:
+
+    QVector<int> m_categoryTerminalIds;         //!< Terminal id for each token category.
+    QHash<QString, int> m_lexemeTerminalIds;    //!< Terminal id for each keyword and character token.
+    int m_size;                                 //!< Count of terminals.
+
+};
+
+#endif // TERMINALIDTABLE_H
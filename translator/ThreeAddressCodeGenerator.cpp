@@ -2,115 +2,120 @@
 #include "Expression.h"
 #include "ErrorGenerator.h"
 
-void ThreeAddressCodeGenerator::generate(const QList<Token> &tokenList)
+void ThreeAddressCodeGenerator::generate(const TokenStream &tokenStream, const SyntaxTree &syntaxTree)
 {
-    this->prepareToCodeGeneration(tokenList);
-    QList<Token>::iterator currentToken = m_tokenList.begin();
-    this->generateCode(currentToken);
+    this->prepareToCodeGeneration(tokenStream);
+    if (!syntaxTree.isEmpty())
+        this->generateCode(syntaxTree);
 }
 
-void ThreeAddressCodeGenerator::prepareToCodeGeneration(const QList<Token> &tokenList)
+void ThreeAddressCodeGenerator::prepareToCodeGeneration(const TokenStream &tokenStream)
 {
     m_labelCount = 0;
-    m_tokenList = tokenList;
     m_threeAddressCode.clear();
-    m_error.clear();
-    int index = 0;
-    while (index < m_tokenList.length()) {
-        if (m_tokenList[index].lexeme() == "DIM") {
-            deleteIdentifierDeclaration(index);
-        } else if (m_tokenList[index].category() == Token::SPACE_CATEGORY) {
-            m_tokenList.removeAt(index);
-        } else {
-            index++;
+    m_diagnostics.clear();
+    m_tokenStream = tokenStream;
+}
+
+void ThreeAddressCodeGenerator::generateCode(const SyntaxTree &syntaxTree)
+{
+    // Nodes are visited in order of tokens, headers of statements are parsed and not visited
+    QVector<int> nodeStack;
+    nodeStack.append(syntaxTree.root());
+    while (!nodeStack.isEmpty()) {
+        int node = nodeStack.last();
+        nodeStack.removeLast();
+        if (syntaxTree.isToken(node)) {
+            int currentToken = syntaxTree.tokenIndex(node);
+            if (m_tokenStream.lexemeEquals(currentToken, "NEXT")) {
+                // NEXT <ID>
+                int idPosition = syntaxTree.childPosition(node) + 1;
+                int statementNode = syntaxTree.parent(node);
+                int idToken = (idPosition < syntaxTree.childCount(statementNode))
+                        ? syntaxTree.firstTokenIndex(syntaxTree.child(statementNode, idPosition))
+                        : -1;
+                this->parseEndForStatement(idToken);
+            } else if (m_tokenStream.lexemeEquals(currentToken, "END")) {
+                this->parseEndIfStatement();
+            }
+            continue;
         }
+
+        int bodyPosition = 0;
+        if ((syntaxTree.childCount(node) > 0) && syntaxTree.isToken(syntaxTree.child(node, 0))) {
+            int currentToken = syntaxTree.tokenIndex(syntaxTree.child(node, 0));
+            if (m_tokenStream.category(currentToken) == Token::IDENTIFIER_CATEGORY) {
+                this->parseAssignmentStatement(this->statementHeader(syntaxTree, node, bodyPosition));
+            } else if (m_tokenStream.lexemeEquals(currentToken, "FOR")) {
+                this->parseBeginForStatement(this->statementHeader(syntaxTree, node, bodyPosition));
+            } else if (m_tokenStream.lexemeEquals(currentToken, "IF")) {
+                this->parseBeginIfStatement(this->statementHeader(syntaxTree, node, bodyPosition));
+            } else if (m_tokenStream.lexemeEquals(currentToken, "DIM")) {
+                // Declarations of identifiers are not used
+                this->statementHeader(syntaxTree, node, bodyPosition);
+            }
+        }
+        for (int position = syntaxTree.childCount(node) - 1; position >= bodyPosition; position--)
+            nodeStack.append(syntaxTree.child(node, position));
     }
 }
 
-void ThreeAddressCodeGenerator::deleteIdentifierDeclaration(int index)
+QVector<int> ThreeAddressCodeGenerator::statementHeader(const SyntaxTree &syntaxTree, int node, int &bodyPosition) const
 {
-    while (m_tokenList[index].category() != Token::LINE_FEED_CATEGORY) {
-        m_tokenList.removeAt(index);
-    }
-    m_tokenList.removeAt(index);
-}
-
-void ThreeAddressCodeGenerator::generateCode(QList<Token>::iterator &currentToken)
-{
-    while (currentToken != m_tokenList.end()) {
-        if (currentToken->category() == Token::IDENTIFIER_CATEGORY) {
-            this->parseAssignmentStatement(currentToken);
-        } else if (currentToken->lexeme() == "FOR") {
-            this->parseBeginForStatement(currentToken);
-        } else if (currentToken->lexeme() == "IF") {
-            this->parseBeginIfStatement(currentToken);
-        } else if (currentToken->lexeme() == "NEXT"){
-            this->parseEndForStatement(currentToken);
-        } else if (currentToken->lexeme() == "END"){
-            this->parseEndIfStatement(currentToken);
-        } else {
-            ++currentToken;
-        }
+    QVector<int> tokenNodes;
+    bodyPosition = 0;
+    while (bodyPosition < syntaxTree.childCount(node)) {
+        int child = syntaxTree.child(node, bodyPosition);
+        if (syntaxTree.isToken(child) && (m_tokenStream.category(syntaxTree.tokenIndex(child)) == Token::LINE_FEED_CATEGORY))
+            break;
+        syntaxTree.appendTokenNodes(child, tokenNodes);
+        bodyPosition++;
     }
+
+    QVector<int> header;
+    header.reserve(tokenNodes.size());
+    foreach (int tokenNode, tokenNodes)
+        header.append(syntaxTree.tokenIndex(tokenNode));
+    return header;
 }
 
-void ThreeAddressCodeGenerator::parseAssignmentStatement(QList<Token>::iterator &currentToken)
+void ThreeAddressCodeGenerator::parseAssignmentStatement(const QVector<int> &header)
 {
-    // currentToken
-    //  |
     // <ID> = <EXP>
-    Token idToken = *currentToken;
-    Expression expression = getNextExpression(currentToken += 2);
+    Token idToken = m_tokenStream.token(header.first());
+    Expression expression = this->getExpression(header, this->findLexeme(header, "=") + 1);
     if (idToken.type() != expression.result().type()) {
-        m_error += ErrorGenerator::incorrectTypeToAssignment(idToken);
+        m_diagnostics.append(ErrorGenerator::incorrectTypeToAssignment(idToken));
         return;
     }
     this->addAssignmentToThreeAddressCode(idToken, expression);
-
-    ++currentToken;
 }
 
-void ThreeAddressCodeGenerator::parseBeginForStatement(QList<Token>::iterator &currentToken)
+void ThreeAddressCodeGenerator::parseBeginForStatement(const QVector<int> &header)
 {
-    // currentToken
-    //  |
-    // FOR <ID> = <EXP> TO <EXP> (STEP <EXP>)?
-    Token idToken = *(++currentToken);
-
-    //    currentToken
-    //       |
-    // FOR <ID> = <EXP> TO <EXP> (STEP <EXP>)?
-    Expression beginExpression = this->getNextExpression(currentToken +=2);
-
-    //             currentToken
-    //                  |
-    // FOR <ID> = <EXP> TO <EXP> (STEP <EXP>)?
-    Expression endExpression = this->getNextExpression(++currentToken);
-
-    //                        currentToken
-    //                             |
     // FOR <ID> = <EXP> TO <EXP> (STEP <EXP>)?
+    int assignmentPosition = this->findLexeme(header, "=");
+    int endPosition = this->findLexeme(header, "TO", assignmentPosition);
+    int stepPosition = this->findLexeme(header, "STEP", endPosition);
+    Token idToken = m_tokenStream.token(header.at(assignmentPosition - 1));
+    Expression beginExpression = this->getExpression(header, assignmentPosition + 1, endPosition);
+    Expression endExpression = this->getExpression(header, endPosition + 1, stepPosition);
     Expression stepExpression;
-    if ((++currentToken)->lexeme() == "STEP") {
-        stepExpression = this->getNextExpression(++currentToken);
+    if (stepPosition >= 0) {
+        stepExpression = this->getExpression(header, stepPosition + 1);
     }
 
     QString label = QString("A%1:").arg(m_labelCount++);
     m_forStatementStack.push_front(ForStatement(idToken, beginExpression, endExpression, label, stepExpression));
     this->addAssignmentToThreeAddressCode(idToken, beginExpression);
     this->addLabel(label);
-
-    ++currentToken;
 }
 
-void ThreeAddressCodeGenerator::parseEndForStatement(QList<Token>::iterator &currentToken)
+void ThreeAddressCodeGenerator::parseEndForStatement(int idToken)
 {
     ForStatement currentFor = m_forStatementStack.takeFirst();
-    // currentToken
-    //  |
-    // NEXT <ID>
-    if ((++currentToken)->lexeme() != currentFor.m_id.lexeme()) {
-        m_error += ErrorGenerator::incorrectIdentifier(*currentToken);
+    if ((idToken >= 0) && !m_tokenStream.lexemeEquals(idToken, currentFor.m_id.lexeme())) {
+        m_diagnostics.append(ErrorGenerator::incorrectIdentifier(m_tokenStream.token(idToken)));
     }
 
     if (currentFor.m_stepExpression.codeList().isEmpty()) {
@@ -120,34 +125,24 @@ void ThreeAddressCodeGenerator::parseEndForStatement(QList<Token>::iterator &cur
     }
     this->addTriade("<",  currentFor.m_id.lexeme(), currentFor.m_endExpression);
     this->addGoto("true", currentFor.m_label);
-
-    ++currentToken;
 }
 
-void ThreeAddressCodeGenerator::parseBeginIfStatement(QList<Token>::iterator &currentToken)
+void ThreeAddressCodeGenerator::parseBeginIfStatement(const QVector<int> &header)
 {
-    // currentToken
-    // |
     // IF <EXP> THEN
-    Expression ifExpression = this->getNextExpression(++currentToken);
+    Expression ifExpression = this->getExpression(header, 1, this->findLexeme(header, "THEN"));
 
     QString label = QString("A%1:").arg(m_labelCount++);
     m_ifStatementStack.push_front(IfStatement(ifExpression, label));
     m_threeAddressCode += ifExpression.codeList();
     this->addGoto("false", label);
-
-    currentToken += 2;
 }
 
-void ThreeAddressCodeGenerator::parseEndIfStatement(QList<Token>::iterator &currentToken)
+void ThreeAddressCodeGenerator::parseEndIfStatement()
 {
-    // currentToken
-    //  |
     // END IF
     IfStatement currentIf = m_ifStatementStack.takeFirst();
     this->addLabel(currentIf.m_label);
-
-    currentToken +=2;
 }
 
 void ThreeAddressCodeGenerator::addAssignmentToThreeAddressCode(const Token &token, const Expression &expression)
@@ -188,28 +183,36 @@ void ThreeAddressCodeGenerator::addLabel(const QString &label)
     m_threeAddressCode += label + "\n";
 }
 
-Expression ThreeAddressCodeGenerator::getNextExpression(QList<Token>::iterator &currentToken)
+Expression ThreeAddressCodeGenerator::getExpression(const QVector<int> &header, int begin, int end)
 {
+    if (end < 0)
+        end = header.size();
     QList<Token> currentList;
-    bool keyWordButNotTrueFalse = false;
-    while ((currentToken != m_tokenList.end())
-           &&(currentToken->category() != Token::LINE_FEED_CATEGORY)
-           &&(!keyWordButNotTrueFalse)) {
-        currentList.push_back(*currentToken);
-        ++currentToken;
-        keyWordButNotTrueFalse = (currentToken->category() == Token::KEYWORD_CATEGORY)
-                                &&(currentToken->lexeme() != "TRUE")
-                                &&(currentToken->lexeme() != "FALSE");
-    }
+    for (int position = begin; position < end; position++)
+        currentList.push_back(m_tokenStream.token(header.at(position)));
 
     Expression exp = Expression(currentList);
-    m_error += exp.error();
+    m_diagnostics.append(exp.diagnostics());
     return exp;
 }
 
+int ThreeAddressCodeGenerator::findLexeme(const QVector<int> &header, const QString &lexeme, int begin) const
+{
+    for (int position = qMax(begin, 0); position < header.size(); position++) {
+        if (m_tokenStream.lexemeEquals(header.at(position), lexeme))
+            return position;
+    }
+    return -1;
+}
+
 QString ThreeAddressCodeGenerator::errorText() const
 {
-    return m_error;
+    return m_diagnostics.text();
+}
+
+const DiagnosticList &ThreeAddressCodeGenerator::diagnostics() const
+{
+    return m_diagnostics;
 }
 
 QString ThreeAddressCodeGenerator::threeAddressCode() const
@@ -3,7 +3,10 @@
 
 #include <QList>
 #include "Token.h"
+#include "TokenStream.h"
 #include "Expression.h"
+#include "Diagnostic.h"
+#include "SyntaxTree.h"
 
 struct ForStatement
 {
@@ -44,22 +47,39 @@ class ThreeAddressCodeGenerator
 {
 public:
 
-    void generate(const QList<Token> &tokenList);
+    /*!
+     * This method used to generate three address code. Statements are found in syntax tree, tokens of statement
+     * before line feed are its header and nested statements follow it.
+     *
+     * @param[in] tokenStream Stream of tokens after semantic analysis.
+     * @param[in] syntaxTree Syntax tree of token stream.
+     */
+    void generate(const TokenStream &tokenStream, const SyntaxTree &syntaxTree);
 
     QString threeAddressCode() const;
 
     QString errorText() const;
+    const DiagnosticList &diagnostics() const;
 
 private:
 
-    void prepareToCodeGeneration(const QList<Token> &tokenList);
-    void deleteIdentifierDeclaration(int index);
-    void generateCode(QList<Token>::iterator &currentToken);
-    void parseAssignmentStatement(QList<Token>::iterator &currentToken);
-    void parseBeginForStatement(QList<Token>::iterator &currentToken);
-    void parseEndForStatement(QList<Token>::iterator &currentToken);
-    void parseBeginIfStatement(QList<Token>::iterator &currentToken);
-    void parseEndIfStatement(QList<Token>::iterator &currentToken);
+    void prepareToCodeGeneration(const TokenStream &tokenStream);
+    void generateCode(const SyntaxTree &syntaxTree);
+
+    /*!
+     * This method used to get tokens of statement header. Header is part of rule before line feed.
+     *
+     * @param[in] syntaxTree Syntax tree.
+     * @param[in] node Index of statement node.
+     * @param[out] bodyPosition Position of first child after header.
+     * @return Indexes of header tokens.
+     */
+    QVector<int> statementHeader(const SyntaxTree &syntaxTree, int node, int &bodyPosition) const;
+    void parseAssignmentStatement(const QVector<int> &header);
+    void parseBeginForStatement(const QVector<int> &header);
+    void parseEndForStatement(int idToken);
+    void parseBeginIfStatement(const QVector<int> &header);
+    void parseEndIfStatement();
 
     void addAssignmentToThreeAddressCode(const Token &token, const Expression &expression);
     void addTriade(const QString &result, const QString &first, const QString &second, const QString &third);
@@ -69,15 +89,33 @@ private:
     void addGoto(const QString &reason, const QString &label);
     void addLabel(const QString &label);
 
-    Expression getNextExpression(QList<Token>::iterator &currentToken);
-
-    QList<Token> m_tokenList;
+    /*!
+     * This method used to make expression of header tokens.
+     *
+     * @param[in] header Indexes of header tokens.
+     * @param[in] begin Position of first expression token.
+     * @param[in] end Position after last expression token or -1 for header end.
+     * @return Expression.
+     */
+    Expression getExpression(const QVector<int> &header, int begin, int end = -1);
+
+    /*!
+     * This method used to find token of header by lexeme.
+     *
+     * @param[in] header Indexes of header tokens.
+     * @param[in] lexeme Lexeme.
+     * @param[in] begin Position to start search.
+     * @return Position of token or -1 if there is no such token.
+     */
+    int findLexeme(const QVector<int> &header, const QString &lexeme, int begin = 0) const;
+
+    TokenStream m_tokenStream;
     QString m_threeAddressCode;
     QList<ForStatement> m_forStatementStack;
     QList<IfStatement> m_ifStatementStack;
     int m_labelCount;
 
-    QString m_error;
+    DiagnosticList m_diagnostics;
 
 };
 
@@ -3,8 +3,18 @@
 
 QHash<QString,Token::TokenCategory> Token::m_convertingStringToTokenCategoryHash;
 
+Token::Token() :
+    m_lexemeBegin(0),
+    m_lexemeLength(0),
+    m_tokenCategory(Token::NONE_CATEGORY),
+    m_identifier(NULL),
+    m_type(Expression::NONE_TYPE)
+{}
+
 Token::Token(const Token &otherToken) :
-    m_lexeme(otherToken.lexeme()),
+    m_source(otherToken.m_source),
+    m_lexemeBegin(otherToken.m_lexemeBegin),
+    m_lexemeLength(otherToken.m_lexemeLength),
     m_tokenCategory(otherToken.category()),
     m_errorInformation(otherToken.errorInformation()),
     m_position(otherToken.position()),
@@ -17,7 +27,26 @@ Token::Token(const QString &lexeme,
              const QString &errorInformation,
              const QPoint &position,
              Expression::Type type) :
-    m_lexeme(lexeme),
+    m_source(lexeme),
+    m_lexemeBegin(0),
+    m_lexemeLength(lexeme.length()),
+    m_tokenCategory(tokenCategory),
+    m_errorInformation(errorInformation),
+    m_position(position),
+    m_identifier(NULL),
+    m_type(type)
+{}
+
+Token::Token(const QString &sourceCode,
+             int lexemeBegin,
+             int lexemeLength,
+             Token::TokenCategory tokenCategory,
+             const QString &errorInformation,
+             const QPoint &position,
+             Expression::Type type) :
+    m_source(sourceCode),
+    m_lexemeBegin(lexemeBegin),
+    m_lexemeLength(lexemeLength),
     m_tokenCategory(tokenCategory),
     m_errorInformation(errorInformation),
     m_position(position),
@@ -30,7 +59,9 @@ Token &Token::operator=(const Token &otherToken)
     if (this == &otherToken)
         return *this;
 
-    m_lexeme = otherToken.lexeme();
+    m_source = otherToken.m_source;
+    m_lexemeBegin = otherToken.m_lexemeBegin;
+    m_lexemeLength = otherToken.m_lexemeLength;
     m_tokenCategory = otherToken.category();
     m_errorInformation = otherToken.errorInformation();
     m_position = otherToken.position();
@@ -40,7 +71,30 @@ Token &Token::operator=(const Token &otherToken)
 
 QString Token::lexeme() const
 {
-    return m_lexeme;
+    if (m_lexemeBegin == 0 && m_lexemeLength == m_source.length())
+        return m_source;
+    return m_source.mid(m_lexemeBegin, m_lexemeLength);
+}
+
+QStringRef Token::lexemeRef() const
+{
+    return QStringRef(&m_source, m_lexemeBegin, m_lexemeLength);
+}
+
+int Token::lexemeBegin() const
+{
+    return m_lexemeBegin;
+}
+
+int Token::lexemeLength() const
+{
+    return m_lexemeLength;
+}
+
+void Token::setSourceCode(const QString &sourceCode, int lexemeBegin)
+{
+    m_source = sourceCode;
+    m_lexemeBegin = lexemeBegin;
 }
 
 Token::TokenCategory Token::category() const
@@ -107,7 +161,7 @@ QString Token::errorInformation() const
 
 QString Token::getErrorInformationWithLexeme() const
 {
-    return m_lexeme + ": " + m_errorInformation;
+    return this->lexeme() + ": " + m_errorInformation;
 }
 
 QString MakeStringRepresentation(const Token &token)
@@ -138,17 +192,18 @@ int GetTokenLineNumber(const Token &token)
 
 int GetOperationPriority(const Token &token)
 {
-    if (token.lexeme() == "(" || token.lexeme() == ")") {
+    QStringRef lexeme = token.lexemeRef();
+    if (lexeme == "(" || lexeme == ")") {
         return 0;
-    } else if (token.lexeme() == "=="
-               || token.lexeme() == "<"
-               || token.lexeme() == ">"
-               || token.lexeme() == "<="
-               || token.lexeme() == ">=") {
+    } else if (lexeme == "=="
+               || lexeme == "<"
+               || lexeme == ">"
+               || lexeme == "<="
+               || lexeme == ">=") {
         return 1;
-    } else if (token.lexeme() == "+" || token.lexeme() == "-") {
+    } else if (lexeme == "+" || lexeme == "-") {
         return 2;
-    } else if (token.lexeme() == "*" || token.lexeme() == "/") {
+    } else if (lexeme == "*" || lexeme == "/") {
         return 3;
     } else {
         return -1;
@@ -12,11 +12,15 @@
 
 #include <QPoint>
 #include <QString>
+#include <QStringRef>
 #include <QHash>
 #include "Expression.h"
 
 /*!
  * @brief This class used to store informations about tokens.
+ *
+ * Token does not own its lexeme. It stores implicitly shared source code and position of lexeme in it,
+ * so lexeme is copied only when lexeme() is called.
  */
 class Identifier;
 class Token
@@ -38,13 +42,61 @@ public:
         STRING_LITERAL_CATEGORY = 7     //!< String litaral (e.g. "literal1", "literal2" ...).
     };
 
-    Token(){}
+    /*!
+     * @brief This enumerate include reasons of incorrect tokens.
+     */
+    enum LexicalError {
+        UNKNOWN_STRING_ERROR                = 0,    //!< Lexeme is not begin of any token.
+        WRONG_NUMBER_AFTER_DIGITS_ERROR     = 1,    //!< Wrong character after digits (e.g. 12A).
+        WRONG_NUMBER_AFTER_POINT_ERROR      = 2,    //!< Wrong character after "." (e.g. 12.A).
+        WRONG_NUMBER_ERROR                  = 3,    //!< Wrong character after fractional part or exponent.
+        WRONG_NUMBER_AFTER_EXPONENT_ERROR   = 4,    //!< Wrong character after "E" (e.g. 12EA).
+        MISSING_EXPONENT_DIGITS_ERROR       = 5,    //!< Wrong character after sign of exponent (e.g. 12E-A).
+        NUMBER_TOO_LONG_ERROR               = 6,    //!< Number literal is longer than maximum.
+        WRONG_IDENTIFIER_ERROR              = 7,    //!< Word doesn't match identifier regexp.
+        IDENTIFIER_TOO_LONG_ERROR           = 8,    //!< Identifier is longer than maximum.
+        MISSING_STRING_END_ERROR            = 9,    //!< String literal has no closing delimiter.
+        STRING_TOO_LONG_ERROR               = 10    //!< String literal is longer than maximum.
+    };
+
+    Token();
     Token(const Token &other);
     Token(const QString &lexeme, TokenCategory category, const QString &errorInformation = "", const QPoint &position = QPoint(), Expression::Type type = Expression::NONE_TYPE);
 
+    /*!
+     * This constructor used to create token which lexeme is part of source code.
+     *
+     * @param[in] sourceCode Source code.
+     * @param[in] lexemeBegin Index of first lexeme character in source code.
+     * @param[in] lexemeLength Length of lexeme.
+     * @param[in] category Token category.
+     * @param[in] errorInformation Error information.
+     * @param[in] position Token position.
+     * @param[in] type Token type.
+     */
+    Token(const QString &sourceCode, int lexemeBegin, int lexemeLength, TokenCategory category, const QString &errorInformation = "", const QPoint &position = QPoint(), Expression::Type type = Expression::NONE_TYPE);
+
     Token& operator=(const Token& newToken);
 
     QString lexeme() const;
+
+    /*!
+     * This method used to get lexeme without copying.
+     *
+     * @return Reference on lexeme in source code. It is valid while token exists.
+     */
+    QStringRef lexemeRef() const;
+    int lexemeBegin() const;
+    int lexemeLength() const;
+
+    /*!
+     * This method used to move lexeme to other source code which contains the same lexeme.
+     *
+     * @param[in] sourceCode Source code.
+     * @param[in] lexemeBegin Index of first lexeme character in source code.
+     */
+    void setSourceCode(const QString &sourceCode, int lexemeBegin);
+
     TokenCategory category() const;
     QString errorInformation() const;
 
@@ -70,7 +122,9 @@ public:
 
 private:
 
-    QString m_lexeme;               //!< Tokens lexeme.
+    QString m_source;               //!< Source code which contains lexeme.
+    int m_lexemeBegin;              //!< Index of lexeme in source code.
+    int m_lexemeLength;             //!< Length of lexeme.
     TokenCategory m_tokenCategory;  //!< Tokens category.
     QString m_errorInformation;     //!< Tokens error information.
     QPoint m_position;              //!< Tokens position.
@@ -0,0 +1,163 @@
+#include "TokenCursor.h"
+#include "LexicalAnalyzer.h"
+#include "ErrorGenerator.h"
+#include <QIODevice>
+#include <QStringList>
+
+TokenCursor::TokenCursor(LexicalAnalyzer *lexicalAnalyzer, QIODevice *device) :
+    m_lexicalAnalyzer(lexicalAnalyzer),
+    m_device(device),
+    m_index(0),
+    m_lineNumber(0),
+    m_lineBeginIndex(0),
+    m_isTokenStreamCursor(false),
+    m_tokenIndex(0),
+    m_hasStreamTerminalIds(false),
+    m_hasPeekedToken(false),
+    m_spacesSkipped(false)
+{
+    if (!m_lexicalAnalyzer->isTransitionTableCompiled())
+        m_lexicalAnalyzer->compileTransitionTable();
+}
+
+TokenCursor::TokenCursor(const QList<Token> &tokenList) :
+    m_lexicalAnalyzer(NULL),
+    m_device(NULL),
+    m_index(0),
+    m_lineNumber(0),
+    m_lineBeginIndex(0),
+    m_tokenList(tokenList),
+    m_isTokenStreamCursor(false),
+    m_tokenIndex(0),
+    m_hasStreamTerminalIds(false),
+    m_hasPeekedToken(false),
+    m_spacesSkipped(false)
+{}
+
+TokenCursor::TokenCursor(const TokenStream &tokenStream, int beginIndex) :
+    m_lexicalAnalyzer(NULL),
+    m_device(NULL),
+    m_index(0),
+    m_lineNumber(0),
+    m_lineBeginIndex(0),
+    m_tokenStream(tokenStream),
+    m_isTokenStreamCursor(true),
+    m_tokenIndex(beginIndex),
+    m_hasStreamTerminalIds(false),
+    m_hasPeekedToken(false),
+    m_spacesSkipped(false)
+{}
+
+void TokenCursor::setSpacesSkipped(bool isSkipped)
+{
+    m_spacesSkipped = isSkipped;
+}
+
+bool TokenCursor::spacesSkipped() const
+{
+    return m_spacesSkipped;
+}
+
+bool TokenCursor::atEnd()
+{
+    if (m_isTokenStreamCursor)
+        return m_tokenIndex >= m_tokenStream.size();
+    if (!m_hasPeekedToken)
+        m_hasPeekedToken = this->readToken(m_peekedToken);
+    return !m_hasPeekedToken;
+}
+
+Token TokenCursor::nextToken()
+{
+    Token token = this->peek();
+    this->skipToken();
+    return token;
+}
+
+Token TokenCursor::peek()
+{
+    if (this->atEnd())
+        return Token();
+    // Token of stream is made only when it is needed
+    if (m_isTokenStreamCursor)
+        return m_tokenStream.token(m_tokenIndex);
+    return m_peekedToken;
+}
+
+void TokenCursor::skipToken()
+{
+    if (this->atEnd())
+        return;
+    if (m_isTokenStreamCursor)
+        m_tokenIndex++;
+    else
+        m_hasPeekedToken = false;
+}
+
+void TokenCursor::setTerminalIdTable(const TerminalIdTable &terminalIdTable)
+{
+    m_terminalIdTable = terminalIdTable;
+    m_hasStreamTerminalIds = m_isTokenStreamCursor && (m_tokenStream.terminalIdTable() == terminalIdTable);
+}
+
+int TokenCursor::peekTerminalId()
+{
+    if (this->atEnd())
+        return TerminalIdTable::UNKNOWN_TERMINAL;
+
+    // Lexical analyzer gives no ids to wrong tokens, but lexeme of wrong token still can be terminal
+    if (m_hasStreamTerminalIds && (m_tokenStream.category(m_tokenIndex) != Token::NONE_CATEGORY))
+        return m_tokenStream.terminalId(m_tokenIndex);
+    Token token = this->peek();
+    return m_terminalIdTable.terminalId(token.category(), token.lexeme());
+}
+
+QString TokenCursor::errorText() const
+{
+    return m_diagnostics.text();
+}
+
+const DiagnosticList &TokenCursor::diagnostics() const
+{
+    return m_diagnostics;
+}
+
+bool TokenCursor::readToken(Token &token)
+{
+    do {
+        if (m_lexicalAnalyzer == NULL) {
+            if (m_tokenIndex >= m_tokenList.size())
+                return false;
+            token = m_tokenList.at(m_tokenIndex++);
+            continue;
+        }
+
+        if ((m_index >= m_sourceCode.length()) && !this->readLine())
+            return false;
+        token = m_lexicalAnalyzer->getNextToken(m_sourceCode, m_index, QPoint(m_index - m_lineBeginIndex, m_lineNumber));
+        if (token.category() == Token::LINE_FEED_CATEGORY) {
+            m_lineNumber++;
+            m_lineBeginIndex = m_index;
+        } else if (!token.isCorrect()) {
+            this->addError(ErrorGenerator::lexicalError(token));
+        }
+    } while (m_spacesSkipped && (token.category() == Token::SPACE_CATEGORY));
+    return true;
+}
+
+bool TokenCursor::readLine()
+{
+    if ((m_device == NULL) || m_device->atEnd())
+        return false;
+
+    // Line is read with line feed, token can't be longer than line
+    m_sourceCode = QString::fromUtf8(m_device->readLine());
+    m_index = 0;
+    m_lineBeginIndex = 0;
+    return !m_sourceCode.isEmpty();
+}
+
+void TokenCursor::addError(const Diagnostic &error)
+{
+    m_diagnostics.append(error);
+}
@@ -0,0 +1,148 @@
+#ifndef TOKENCURSOR_H
+#define TOKENCURSOR_H
+
+#include <QString>
+#include <QList>
+#include "Token.h"
+#include "TokenStream.h"
+#include "TerminalIdTable.h"
+#include "Diagnostic.h"
+
+class LexicalAnalyzer;
+class QIODevice;
+
+/*!
+ * @brief This class used to read tokens one by one.
+ *
+ * Cursor analyzes source code only when next token is needed. Source code is read from device line by line,
+ * so only current line and unread tokens are stored in memory. Cursor can also walk through list or stream
+ * of tokens which were analyzed before.
+ */
+class TokenCursor
+{
+
+public:
+
+    /*!
+     * This constructor used to create cursor over device. Device must be opened for reading.
+     *
+     * @param[in] lexicalAnalyzer Lexical analyzer with loaded settings.
+     * @param[in] device Device with UTF-8 source code.
+     */
+    TokenCursor(LexicalAnalyzer *lexicalAnalyzer, QIODevice *device);
+
+    /*!
+     * This constructor used to create cursor over analyzed tokens.
+     *
+     * @param[in] tokenList List of tokens.
+     */
+    explicit TokenCursor(const QList<Token> &tokenList);
+
+    /*!
+     * This constructor used to create cursor over analyzed token stream.
+     * Token object is made only for token which is read.
+     *
+     * @param[in] tokenStream Stream of tokens.
+     * @param[in] beginIndex Index of first token to read.
+     */
+    explicit TokenCursor(const TokenStream &tokenStream, int beginIndex = 0);
+
+    /*!
+     * This method used to skip space tokens of token list or device. Token stream has no space tokens.
+     *
+     * @param[in] isSkipped Are spaces skipped.
+     */
+    void setSpacesSkipped(bool isSkipped);
+    bool spacesSkipped() const;
+
+    /*!
+     * This method used to check are there more tokens.
+     *
+     * @return If there are no more tokens returns true other returns false.
+     */
+    bool atEnd();
+
+    /*!
+     * This method used to get next token and move cursor.
+     *
+     * @return Next token or empty token at end.
+     */
+    Token nextToken();
+
+    /*!
+     * This method used to get next token without moving cursor.
+     *
+     * @return Next token or empty token at end.
+     */
+    Token peek();
+
+    /*!
+     * This method used to move cursor without making token object.
+     */
+    void skipToken();
+
+    /*!
+     * This method used to set table which terminal ids of tokens are taken from.
+     *
+     * @param[in] terminalIdTable Terminal id table of syntactic analyzer.
+     */
+    void setTerminalIdTable(const TerminalIdTable &terminalIdTable);
+
+    /*!
+     * This method used to get terminal id of next token without moving cursor. Ids written by lexical analyzer
+     * into token stream are used when stream has the same table, other tokens are found by lexemes.
+     *
+     * @return Terminal id or UNKNOWN_TERMINAL at end.
+     */
+    int peekTerminalId();
+
+    /*!
+     * This method returns lexical errors of tokens which were read.
+     *
+     * @return Errors string.
+     */
+    QString errorText() const;
+    const DiagnosticList &diagnostics() const;
+
+private:
+
+    /*!
+     * This method used to get next token from source.
+     *
+     * @param[out] token Next token.
+     * @return If there is token returns true other returns false.
+     */
+    bool readToken(Token &token);
+
+    /*!
+     * This method used to read next line from device.
+     *
+     * @return If line was read returns true other returns false.
+     */
+    bool readLine();
+
+    void addError(const Diagnostic &error);
+
+    LexicalAnalyzer *m_lexicalAnalyzer; //!< Lexical analyzer, NULL for cursor over tokens.
+    QIODevice *m_device;                //!< Source device, NULL for cursor over tokens.
+
+    QString m_sourceCode;               //!< Current line of device.
+    int m_index;                        //!< Index of next token begin in source code.
+    int m_lineNumber;                   //!< Number of current line.
+    int m_lineBeginIndex;               //!< Index of current line begin in source code.
+
+    QList<Token> m_tokenList;           //!< Tokens for cursor over tokens list.
+    TokenStream m_tokenStream;          //!< Tokens for cursor over token stream.
+    bool m_isTokenStreamCursor;         //!< Is cursor over token stream.
+    int m_tokenIndex;                   //!< Index of next token in list or stream.
+    TerminalIdTable m_terminalIdTable;  //!< Table of terminal ids.
+    bool m_hasStreamTerminalIds;        //!< Are terminal ids of token stream taken from the same table.
+
+    Token m_peekedToken;                //!< Token which was read by peek().
+    bool m_hasPeekedToken;              //!< Is there token read by peek().
+    bool m_spacesSkipped;               //!< Are spaces skipped.
+    DiagnosticList m_diagnostics;       //!< Lexical errors of read tokens.
+
+};
+
+#endif // TOKENCURSOR_H
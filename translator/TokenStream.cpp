@@ -0,0 +1,459 @@
+#include "TokenStream.h"
+#include <algorithm>
+#include "ErrorGenerator.h"
+
+/*!
+ * This function used to replace part of vector by other vector.
+ *
+ * @param[in,out] vector Vector.
+ * @param[in] index Index of part begin.
+ * @param[in] count Count of replaced elements.
+ * @param[in] part New elements.
+ */
+template <typename T>
+static void ReplaceVectorPart(QVector<T> &vector, int index, int count, const QVector<T> &part)
+{
+    const int oldSize = vector.size();
+    const int sizeDelta = part.size() - count;
+    if (sizeDelta > 0) {
+        vector.resize(oldSize + sizeDelta);
+        std::copy_backward(vector.begin() + index + count, vector.begin() + oldSize, vector.end());
+    } else if (sizeDelta < 0) {
+        std::copy(vector.begin() + index + count, vector.end(), vector.begin() + index + part.size());
+        vector.resize(oldSize + sizeDelta);
+    }
+    std::copy(part.begin(), part.end(), vector.begin() + index);
+}
+
+TokenStream::TokenStream() :
+    m_isUtf8SourceCode(false),
+    m_maxNumberLiteralLenght(0),
+    m_maxStringLiteralLenght(0),
+    m_maxIdentifierNameLenght(0)
+{
+    m_lineBeginIndexes.append(0);
+}
+
+TokenStream::TokenStream(const QString &sourceCode, int beginIndex) :
+    m_sourceCode(sourceCode),
+    m_isUtf8SourceCode(false),
+    m_maxNumberLiteralLenght(0),
+    m_maxStringLiteralLenght(0),
+    m_maxIdentifierNameLenght(0)
+{
+    m_lineBeginIndexes.append(beginIndex);
+}
+
+TokenStream::TokenStream(const Utf8SourceCode &sourceCode, int beginIndex) :
+    m_utf8SourceCode(sourceCode),
+    m_isUtf8SourceCode(true),
+    m_maxNumberLiteralLenght(0),
+    m_maxStringLiteralLenght(0),
+    m_maxIdentifierNameLenght(0)
+{
+    m_lineBeginIndexes.append(beginIndex);
+}
+
+void TokenStream::clear()
+{
+    m_sourceCode.clear();
+    m_utf8SourceCode.clear();
+    m_isUtf8SourceCode = false;
+    m_categories.clear();
+    m_types.clear();
+    m_lexemeBegins.clear();
+    m_lexemeLengths.clear();
+    m_lineNumbers.clear();
+    m_ids.clear();
+    m_numberLiterals.clear();
+    m_terminalIds.clear();
+    m_lexicalErrors.clear();
+    m_terminalIdTable.clear();
+    m_lineBeginIndexes.fill(0, 1);
+    m_triviaTokenIndexes.clear();
+    m_triviaBegins.clear();
+    m_triviaLengths.clear();
+}
+
+QString TokenStream::sourceCode() const
+{
+    if (m_isUtf8SourceCode)
+        return m_utf8SourceCode.toString();
+    return m_sourceCode;
+}
+
+bool TokenStream::isUtf8SourceCode() const
+{
+    return m_isUtf8SourceCode;
+}
+
+int TokenStream::size() const
+{
+    return m_categories.size();
+}
+
+bool TokenStream::isEmpty() const
+{
+    return m_categories.isEmpty();
+}
+
+void TokenStream::append(Token::TokenCategory category,
+                         Expression::Type type,
+                         int lexemeBegin,
+                         int lexemeLength,
+                         int id,
+                         const NumberLiteral &numberLiteral,
+                         int terminalId,
+                         Token::LexicalError lexicalError)
+{
+    m_categories.append(category);
+    m_types.append(type);
+    m_lexemeBegins.append(lexemeBegin);
+    m_lexemeLengths.append(lexemeLength);
+    m_lineNumbers.append(m_lineBeginIndexes.size() - 1);
+    m_ids.append(id);
+    m_numberLiterals.append(numberLiteral);
+    m_terminalIds.append(terminalId);
+    m_lexicalErrors.append(lexicalError);
+    if (category == Token::LINE_FEED_CATEGORY)
+        m_lineBeginIndexes.append(lexemeBegin + lexemeLength);
+}
+
+void TokenStream::appendTrivia(int lexemeBegin, int lexemeLength)
+{
+    m_triviaTokenIndexes.append(this->size());
+    m_triviaBegins.append(lexemeBegin);
+    m_triviaLengths.append(lexemeLength);
+}
+
+void TokenStream::append(const TokenStream &other)
+{
+    const int lineDelta = m_lineBeginIndexes.size() - 1;
+    for (int i = 0; i < other.triviaCount(); i++)
+        m_triviaTokenIndexes.append(other.m_triviaTokenIndexes.at(i) + this->size());
+    m_triviaBegins += other.m_triviaBegins;
+    m_triviaLengths += other.m_triviaLengths;
+    m_categories += other.m_categories;
+    m_types += other.m_types;
+    m_lexemeBegins += other.m_lexemeBegins;
+    m_lexemeLengths += other.m_lexemeLengths;
+    m_ids += other.m_ids;
+    m_numberLiterals += other.m_numberLiterals;
+    m_terminalIds += other.m_terminalIds;
+    m_lexicalErrors += other.m_lexicalErrors;
+    for (int i = 0; i < other.size(); i++)
+        m_lineNumbers.append(other.m_lineNumbers.at(i) + lineDelta);
+    for (int i = 1; i < other.m_lineBeginIndexes.size(); i++)
+        m_lineBeginIndexes.append(other.m_lineBeginIndexes.at(i));
+}
+
+void TokenStream::replace(int beginIndex, int endIndex, const TokenStream &tokens, const QString &sourceCode)
+{
+    const int firstLine = this->lineNumberAt(beginIndex);
+    const int endLine = this->lineNumberAt(endIndex) + 1;
+    const int firstTokenIndex = this->tokenIndexAt(beginIndex);
+    const int endTokenIndex = this->tokenIndexAt(endIndex);
+    const int removedTokenCount = endTokenIndex - firstTokenIndex;
+    const int firstTriviaIndex = std::lower_bound(m_triviaBegins.begin(), m_triviaBegins.end(), beginIndex) - m_triviaBegins.begin();
+    const int endTriviaIndex = std::lower_bound(m_triviaBegins.begin(), m_triviaBegins.end(), endIndex) - m_triviaBegins.begin();
+    const int removedTriviaCount = endTriviaIndex - firstTriviaIndex;
+    const int removedLineFeedCount = endLine - firstLine - 1;
+    const int addedLineFeedCount = tokens.m_lineBeginIndexes.size() - 1;
+
+    ReplaceVectorPart(m_categories, firstTokenIndex, removedTokenCount, tokens.m_categories);
+    ReplaceVectorPart(m_types, firstTokenIndex, removedTokenCount, tokens.m_types);
+    ReplaceVectorPart(m_lexemeBegins, firstTokenIndex, removedTokenCount, tokens.m_lexemeBegins);
+    ReplaceVectorPart(m_lexemeLengths, firstTokenIndex, removedTokenCount, tokens.m_lexemeLengths);
+    ReplaceVectorPart(m_lineNumbers, firstTokenIndex, removedTokenCount, tokens.m_lineNumbers);
+    ReplaceVectorPart(m_ids, firstTokenIndex, removedTokenCount, tokens.m_ids);
+    ReplaceVectorPart(m_numberLiterals, firstTokenIndex, removedTokenCount, tokens.m_numberLiterals);
+    ReplaceVectorPart(m_terminalIds, firstTokenIndex, removedTokenCount, tokens.m_terminalIds);
+    ReplaceVectorPart(m_lexicalErrors, firstTokenIndex, removedTokenCount, tokens.m_lexicalErrors);
+    ReplaceVectorPart(m_lineBeginIndexes, firstLine + 1, removedLineFeedCount, tokens.m_lineBeginIndexes.mid(1));
+    for (int i = firstTokenIndex; i < firstTokenIndex + tokens.size(); i++)
+        m_lineNumbers[i] += firstLine;
+    ReplaceVectorPart(m_triviaTokenIndexes, firstTriviaIndex, removedTriviaCount, tokens.m_triviaTokenIndexes);
+    ReplaceVectorPart(m_triviaBegins, firstTriviaIndex, removedTriviaCount, tokens.m_triviaBegins);
+    ReplaceVectorPart(m_triviaLengths, firstTriviaIndex, removedTriviaCount, tokens.m_triviaLengths);
+    for (int i = firstTriviaIndex; i < firstTriviaIndex + tokens.triviaCount(); i++)
+        m_triviaTokenIndexes[i] += firstTokenIndex;
+
+    // Tokens and lines after part are moved
+    const int indexDelta = sourceCode.length() - m_sourceCode.length();
+    const int lineDelta = addedLineFeedCount - removedLineFeedCount;
+    for (int i = firstTokenIndex + tokens.size(); i < m_lexemeBegins.size(); i++) {
+        m_lexemeBegins[i] += indexDelta;
+        m_lineNumbers[i] += lineDelta;
+    }
+    for (int i = firstLine + 1 + addedLineFeedCount; i < m_lineBeginIndexes.size(); i++)
+        m_lineBeginIndexes[i] += indexDelta;
+    for (int i = firstTriviaIndex + tokens.triviaCount(); i < m_triviaBegins.size(); i++) {
+        m_triviaTokenIndexes[i] += tokens.size() - removedTokenCount;
+        m_triviaBegins[i] += indexDelta;
+    }
+    m_sourceCode = sourceCode;
+}
+
+TokenStream TokenStream::filtered(const QVector<bool> &isTokenKept) const
+{
+    TokenStream result(*this);
+    result.m_categories.clear();
+    result.m_types.clear();
+    result.m_lexemeBegins.clear();
+    result.m_lexemeLengths.clear();
+    result.m_lineNumbers.clear();
+    result.m_ids.clear();
+    result.m_numberLiterals.clear();
+    result.m_terminalIds.clear();
+    result.m_lexicalErrors.clear();
+
+    // Trivia of removed token is moved to next kept token
+    QVector<int> newTokenIndexes(this->size() + 1);
+    for (int i = 0; i < this->size(); i++) {
+        newTokenIndexes[i] = result.size();
+        if (!isTokenKept.at(i))
+            continue;
+        result.m_categories.append(m_categories.at(i));
+        result.m_types.append(m_types.at(i));
+        result.m_lexemeBegins.append(m_lexemeBegins.at(i));
+        result.m_lexemeLengths.append(m_lexemeLengths.at(i));
+        result.m_lineNumbers.append(m_lineNumbers.at(i));
+        result.m_ids.append(m_ids.at(i));
+        result.m_numberLiterals.append(m_numberLiterals.at(i));
+        result.m_terminalIds.append(m_terminalIds.at(i));
+        result.m_lexicalErrors.append(m_lexicalErrors.at(i));
+    }
+    newTokenIndexes[this->size()] = result.size();
+    for (int i = 0; i < this->triviaCount(); i++)
+        result.m_triviaTokenIndexes[i] = newTokenIndexes.at(m_triviaTokenIndexes.at(i));
+    return result;
+}
+
+Token::TokenCategory TokenStream::category(int index) const
+{
+    return Token::TokenCategory(m_categories.at(index));
+}
+
+Expression::Type TokenStream::type(int index) const
+{
+    return Expression::Type(m_types.at(index));
+}
+
+void TokenStream::setType(int index, Expression::Type type)
+{
+    m_types[index] = type;
+}
+
+int TokenStream::id(int index) const
+{
+    return m_ids.at(index);
+}
+
+void TokenStream::setId(int index, int id)
+{
+    m_ids[index] = id;
+}
+
+void TokenStream::mapIds(const QVector<int> &newIds)
+{
+    for (int i = 0; i < m_ids.size(); i++) {
+        if (m_ids.at(i) >= 0)
+            m_ids[i] = newIds.at(m_ids.at(i));
+    }
+}
+
+NumberLiteral TokenStream::numberLiteral(int index) const
+{
+    return m_numberLiterals.at(index);
+}
+
+int TokenStream::terminalId(int index) const
+{
+    return m_terminalIds.at(index);
+}
+
+const TerminalIdTable &TokenStream::terminalIdTable() const
+{
+    return m_terminalIdTable;
+}
+
+void TokenStream::setTerminalIdTable(const TerminalIdTable &terminalIdTable)
+{
+    m_terminalIdTable = terminalIdTable;
+}
+
+QString TokenStream::lexeme(int index) const
+{
+    // Line feed lexeme is not part of source code
+    if (m_categories.at(index) == Token::LINE_FEED_CATEGORY)
+        return "linefeed";
+    if (m_isUtf8SourceCode)
+        return QString::fromUtf8(m_utf8SourceCode.data() + m_lexemeBegins.at(index), m_lexemeLengths.at(index));
+    return m_sourceCode.mid(m_lexemeBegins.at(index), m_lexemeLengths.at(index));
+}
+
+bool TokenStream::lexemeEquals(int index, const QString &string) const
+{
+    if (m_categories.at(index) == Token::LINE_FEED_CATEGORY)
+        return string == "linefeed";
+
+    const int length = m_lexemeLengths.at(index);
+    if (!m_isUtf8SourceCode)
+        return QStringRef(&m_sourceCode, m_lexemeBegins.at(index), length) == string;
+
+    // ASCII bytes are compared directly, other lexemes are decoded
+    if (length != string.length())
+        return this->lexeme(index) == string;
+    const char *lexeme = m_utf8SourceCode.data() + m_lexemeBegins.at(index);
+    for (int i = 0; i < length; i++) {
+        if (uchar(lexeme[i]) >= 0x80)
+            return this->lexeme(index) == string;
+        if (uchar(lexeme[i]) != string.at(i).unicode())
+            return false;
+    }
+    return true;
+}
+
+int TokenStream::lexemeBegin(int index) const
+{
+    return m_lexemeBegins.at(index);
+}
+
+int TokenStream::lexemeLength(int index) const
+{
+    return m_lexemeLengths.at(index);
+}
+
+int TokenStream::lineNumber(int index) const
+{
+    return m_lineNumbers.at(index);
+}
+
+QPoint TokenStream::position(int index) const
+{
+    const int lineNumber = m_lineNumbers.at(index);
+    return QPoint(m_lexemeBegins.at(index) - m_lineBeginIndexes.at(lineNumber), lineNumber);
+}
+
+bool TokenStream::isCorrect(int index) const
+{
+    return m_categories.at(index) != Token::NONE_CATEGORY;
+}
+
+Token::LexicalError TokenStream::lexicalError(int index) const
+{
+    return Token::LexicalError(m_lexicalErrors.at(index));
+}
+
+QString TokenStream::errorInformation(int index) const
+{
+    if (this->isCorrect(index))
+        return QString();
+    return ErrorGenerator::lexicalErrorInformation(this->lexicalError(index),
+                                                   m_maxNumberLiteralLenght,
+                                                   m_maxStringLiteralLenght,
+                                                   m_maxIdentifierNameLenght,
+                                                   m_beginStringLiteral);
+}
+
+void TokenStream::setLexicalErrorSettings(int maxNumberLiteralLenght,
+                                          int maxStringLiteralLenght,
+                                          int maxIdentifierNameLenght,
+                                          const QString &beginStringLiteral)
+{
+    m_maxNumberLiteralLenght = maxNumberLiteralLenght;
+    m_maxStringLiteralLenght = maxStringLiteralLenght;
+    m_maxIdentifierNameLenght = maxIdentifierNameLenght;
+    m_beginStringLiteral = beginStringLiteral;
+}
+
+int TokenStream::lineCount() const
+{
+    return m_lineBeginIndexes.size();
+}
+
+int TokenStream::lineBeginIndex(int lineNumber) const
+{
+    return m_lineBeginIndexes.at(lineNumber);
+}
+
+int TokenStream::lineNumberAt(int index) const
+{
+    return std::upper_bound(m_lineBeginIndexes.begin(), m_lineBeginIndexes.end(), index) - m_lineBeginIndexes.begin() - 1;
+}
+
+int TokenStream::tokenIndexAt(int index) const
+{
+    return std::lower_bound(m_lexemeBegins.begin(), m_lexemeBegins.end(), index) - m_lexemeBegins.begin();
+}
+
+Token TokenStream::token(int index) const
+{
+    const Token::TokenCategory category = this->category(index);
+    if ((category == Token::LINE_FEED_CATEGORY) || m_isUtf8SourceCode) {
+        return Token(this->lexeme(index),
+                     category,
+                     this->errorInformation(index),
+                     this->position(index),
+                     this->type(index));
+    }
+
+    return Token(m_sourceCode,
+                 m_lexemeBegins.at(index),
+                 m_lexemeLengths.at(index),
+                 category,
+                 this->errorInformation(index),
+                 this->position(index),
+                 this->type(index));
+}
+
+QList<Token> TokenStream::toList() const
+{
+    QList<Token> tokenList;
+    tokenList.reserve(this->size());
+    for (int i = 0; i < this->size(); i++)
+        tokenList.append(this->token(i));
+    return tokenList;
+}
+
+int TokenStream::triviaCount() const
+{
+    return m_triviaBegins.size();
+}
+
+int TokenStream::triviaTokenIndex(int triviaIndex) const
+{
+    return m_triviaTokenIndexes.at(triviaIndex);
+}
+
+int TokenStream::triviaBegin(int triviaIndex) const
+{
+    return m_triviaBegins.at(triviaIndex);
+}
+
+int TokenStream::triviaLength(int triviaIndex) const
+{
+    return m_triviaLengths.at(triviaIndex);
+}
+
+Token TokenStream::triviaToken(int triviaIndex) const
+{
+    const int lexemeBegin = m_triviaBegins.at(triviaIndex);
+    const int lexemeLength = m_triviaLengths.at(triviaIndex);
+    const int lineNumber = this->lineNumberAt(lexemeBegin);
+    const QPoint position(lexemeBegin - m_lineBeginIndexes.at(lineNumber), lineNumber);
+    if (m_isUtf8SourceCode)
+        return Token(QString::fromUtf8(m_utf8SourceCode.data() + lexemeBegin, lexemeLength), Token::SPACE_CATEGORY, "", position);
+    return Token(m_sourceCode, lexemeBegin, lexemeLength, Token::SPACE_CATEGORY, "", position);
+}
+
+QString MakeStringRepresentation(const TokenStream &tokenStream)
+{
+    QString tokenSequenceString;
+    for (int i = 0; i < tokenStream.size(); i++) {
+        tokenSequenceString += MakeStringRepresentation(tokenStream.token(i));
+        if (tokenStream.category(i) == Token::LINE_FEED_CATEGORY)
+            tokenSequenceString += "\n";
+    }
+    return tokenSequenceString;
+}
@@ -0,0 +1,285 @@
+#ifndef TOKENSTREAM_H
+#define TOKENSTREAM_H
+
+#include <QString>
+#include <QStringRef>
+#include <QVector>
+#include <QPoint>
+#include <QList>
+#include <QtGlobal>
+#include "Token.h"
+#include "NumberLiteral.h"
+#include "Utf8SourceCode.h"
+#include "TerminalIdTable.h"
+
+/*!
+ * @brief This class used to store sequence of tokens in compact form.
+ *
+ * Fields of tokens are stored in parallel arrays and lexemes are stored as indexes in shared source code,
+ * so no memory is allocated for single token. Token position is calculated from line number and line begin
+ * index, error information is calculated from category. Token objects are made only when they are needed.
+ *
+ * Source code is QString or UTF-8 bytes of mapped file. For UTF-8 source code indexes and columns are
+ * counted in bytes and lexemes are decoded when they are needed.
+ *
+ * Spaces are not tokens of stream, they are stored in trivia table by index of next token, so analyzers
+ * never see them and source code can still be rebuilt from tokens and trivia. (e.g. for highlighting)
+ */
+class TokenStream
+{
+
+public:
+
+    TokenStream();
+
+    /*!
+     * This constructor used to create empty stream of source code part.
+     *
+     * @param[in] sourceCode Source code.
+     * @param[in] beginIndex Index of first line begin in source code.
+     */
+    explicit TokenStream(const QString &sourceCode, int beginIndex = 0);
+    explicit TokenStream(const Utf8SourceCode &sourceCode, int beginIndex = 0);
+
+    void clear();
+
+    /*!
+     * This method returns source code of stream. UTF-8 source code is decoded on every call.
+     *
+     * @return Source code.
+     */
+    QString sourceCode() const;
+    bool isUtf8SourceCode() const;
+    int size() const;
+    bool isEmpty() const;
+
+    /*!
+     * This method used to add token to the end of stream. Token is placed at last line, line feed begins new line.
+     *
+     * @param[in] category Token category.
+     * @param[in] type Token type.
+     * @param[in] lexemeBegin Index of first lexeme character in source code.
+     * @param[in] lexemeLength Length of lexeme.
+     * @param[in] id Interned id of lexeme.
+     * @param[in] numberLiteral Decoded value of number literal.
+     * @param[in] terminalId Id of grammar terminal in terminal id table of stream.
+     * @param[in] lexicalError Reason of incorrect token.
+     */
+    void append(Token::TokenCategory category,
+                Expression::Type type,
+                int lexemeBegin,
+                int lexemeLength,
+                int id = -1,
+                const NumberLiteral &numberLiteral = NumberLiteral(),
+                int terminalId = TerminalIdTable::UNKNOWN_TERMINAL,
+                Token::LexicalError lexicalError = Token::UNKNOWN_STRING_ERROR);
+
+    /*!
+     * This method used to add spaces before next token.
+     *
+     * @param[in] lexemeBegin Index of first space in source code.
+     * @param[in] lexemeLength Count of spaces.
+     */
+    void appendTrivia(int lexemeBegin, int lexemeLength);
+
+    /*!
+     * This method used to add stream of next part of the same source code. (e.g. analyzed chunk)
+     *
+     * @param[in] other Stream which first line begins at last line begin of this stream.
+     */
+    void append(const TokenStream &other);
+
+    /*!
+     * This method used to replace tokens of source code part after source code change.
+     * Part must begin at line begin and end at line begin or source code end. Tokens after part are moved.
+     * Source code of stream must be QString.
+     *
+     * @param[in] beginIndex Index of part begin in old source code.
+     * @param[in] endIndex Index of part end in old source code.
+     * @param[in] tokens Stream of changed part of new source code.
+     * @param[in] sourceCode New source code.
+     */
+    void replace(int beginIndex, int endIndex, const TokenStream &tokens, const QString &sourceCode);
+
+    /*!
+     * This method used to get part of stream. Tokens keep their positions, trivia is kept before next kept token.
+     *
+     * @param[in] isTokenKept Is token with the same index kept.
+     * @return Stream with kept tokens.
+     */
+    TokenStream filtered(const QVector<bool> &isTokenKept) const;
+
+    Token::TokenCategory category(int index) const;
+    Expression::Type type(int index) const;
+    void setType(int index, Expression::Type type);
+
+    /*!
+     * This method used to get interned id of token lexeme. Lexemes of identifiers and literals are interned
+     * by lexical analyzer, so tokens with equal lexemes have equal ids.
+     *
+     * @param[in] index Index of token.
+     * @return Id of lexeme in string pool or -1 if lexeme is not interned.
+     */
+    int id(int index) const;
+    void setId(int index, int id);
+
+    /*!
+     * This method used to change ids of lexemes. (e.g. when stream is moved to other string pool)
+     *
+     * @param[in] newIds New id for each old id.
+     */
+    void mapIds(const QVector<int> &newIds);
+
+    /*!
+     * This method used to get value of number literal which was decoded by lexical analyzer.
+     *
+     * @param[in] index Index of token.
+     * @return Decoded literal. For other tokens returns literal with NONE_TYPE.
+     */
+    NumberLiteral numberLiteral(int index) const;
+
+    /*!
+     * This method used to get id of grammar terminal which was found by lexical analyzer.
+     *
+     * @param[in] index Index of token.
+     * @return Id in terminal id table of stream or UNKNOWN_TERMINAL.
+     */
+    int terminalId(int index) const;
+
+    /*!
+     * This method returns table which terminal ids of tokens belong to. Empty table means ids are unknown.
+     *
+     * @return Terminal id table.
+     */
+    const TerminalIdTable &terminalIdTable() const;
+    void setTerminalIdTable(const TerminalIdTable &terminalIdTable);
+
+    QString lexeme(int index) const;
+
+    /*!
+     * This method used to compare lexeme of token with string without copying lexeme.
+     *
+     * @param[in] index Index of token.
+     * @param[in] string String.
+     * @return If lexeme is equal to string returns true other returns false.
+     */
+    bool lexemeEquals(int index, const QString &string) const;
+    int lexemeBegin(int index) const;
+    int lexemeLength(int index) const;
+
+    int lineNumber(int index) const;
+    QPoint position(int index) const;
+    bool isCorrect(int index) const;
+
+    /*!
+     * This method used to get reason of incorrect token which was found by lexical analyzer.
+     *
+     * @param[in] index Index of token.
+     * @return Reason. For correct tokens returns UNKNOWN_STRING_ERROR.
+     */
+    Token::LexicalError lexicalError(int index) const;
+
+    /*!
+     * This method used to make error information of incorrect token from its reason.
+     *
+     * @param[in] index Index of token.
+     * @return Error information. For correct tokens returns empty string.
+     */
+    QString errorInformation(int index) const;
+
+    /*!
+     * This method used to set settings of lexical analyzer which are shown in error information.
+     *
+     * @param[in] maxNumberLiteralLenght Maximum number literal lenght.
+     * @param[in] maxStringLiteralLenght Maximum string literal lenght.
+     * @param[in] maxIdentifierNameLenght Maximum identifier name lenght.
+     * @param[in] beginStringLiteral Begin of string literal.
+     */
+    void setLexicalErrorSettings(int maxNumberLiteralLenght,
+                                 int maxStringLiteralLenght,
+                                 int maxIdentifierNameLenght,
+                                 const QString &beginStringLiteral);
+
+    int lineCount() const;
+    int lineBeginIndex(int lineNumber) const;
+
+    /*!
+     * This method used to find line which contains character of source code.
+     *
+     * @param[in] index Index of character in source code.
+     * @return Line number.
+     */
+    int lineNumberAt(int index) const;
+
+    /*!
+     * This method used to find first token which begins at character of source code or after it.
+     *
+     * @param[in] index Index of character in source code.
+     * @return Index of token or size of stream if there is no such token.
+     */
+    int tokenIndexAt(int index) const;
+
+    /*!
+     * This method used to make token object.
+     *
+     * @param[in] index Index of token.
+     * @return Token which shares source code with stream.
+     */
+    Token token(int index) const;
+    QList<Token> toList() const;
+
+    int triviaCount() const;
+
+    /*!
+     * This method used to get index of token which follows trivia.
+     *
+     * @param[in] triviaIndex Index of trivia.
+     * @return Index of next token or size of stream if trivia is at the end.
+     */
+    int triviaTokenIndex(int triviaIndex) const;
+    int triviaBegin(int triviaIndex) const;
+    int triviaLength(int triviaIndex) const;
+
+    /*!
+     * This method used to make space token of trivia.
+     *
+     * @param[in] triviaIndex Index of trivia.
+     * @return Token with SPACE_CATEGORY.
+     */
+    Token triviaToken(int triviaIndex) const;
+
+private:
+
+    QString m_sourceCode;                    //!< Source code which contains lexemes.
+    Utf8SourceCode m_utf8SourceCode;         //!< UTF-8 source code which contains lexemes.
+    bool m_isUtf8SourceCode;                 //!< Are lexemes stored in UTF-8 source code.
+    QVector<quint8> m_categories;            //!< Category of each token.
+    QVector<quint8> m_types;                 //!< Type of each token.
+    QVector<int> m_lexemeBegins;             //!< Index of each token lexeme in source code.
+    QVector<int> m_lexemeLengths;            //!< Length of each token lexeme.
+    QVector<int> m_lineNumbers;              //!< Line number of each token.
+    QVector<int> m_ids;                      //!< Interned id of each token lexeme.
+    QVector<NumberLiteral> m_numberLiterals; //!< Decoded value of each number literal token.
+    QVector<int> m_terminalIds;              //!< Grammar terminal id of each token.
+    QVector<quint8> m_lexicalErrors;         //!< Reason of each incorrect token.
+    TerminalIdTable m_terminalIdTable;       //!< Table of terminal ids.
+    int m_maxNumberLiteralLenght;            //!< Maximum number literal lenght for error information.
+    int m_maxStringLiteralLenght;            //!< Maximum string literal lenght for error information.
+    int m_maxIdentifierNameLenght;           //!< Maximum identifier name lenght for error information.
+    QString m_beginStringLiteral;            //!< Begin of string literal for error information.
+    QVector<int> m_lineBeginIndexes;         //!< Index in source code of each line begin.
+    QVector<int> m_triviaTokenIndexes;       //!< Index of next token of each trivia.
+    QVector<int> m_triviaBegins;             //!< Index of each trivia in source code.
+    QVector<int> m_triviaLengths;            //!< Length of each trivia.
+
+};
+
+/*!
+ * This function used to convert stream of tokens to string.
+ *
+ * @param[in] tokenStream Stream of tokens.
+ * @return Stream of tokens as string.
+ */
+QString MakeStringRepresentation(const TokenStream &tokenStream);
+
+#endif // TOKENSTREAM_H
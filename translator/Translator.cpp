@@ -4,6 +4,9 @@
 #include "LexicalAnalyzer.h"
 #include "ThreeAddressCodeGenerator.h"
 #include "HTMLMarkupGenerator.h"
+#include "TokenCursor.h"
+#include "ErrorGenerator.h"
+#include <QFile>
 
 const QString Translator::defaultLexicalAnalyzerSettingsFileName = "LexicalAnalyzersSettings.json";
 const QString Translator::defaultSyntacticAnalyzerSettingsFileName = "SyntacticAnalyzersSetting.rules";
@@ -13,7 +16,8 @@ Translator::Translator(QObject *parent) :
     m_syntacticAnalyzer(new SyntacticAnalyzer),
     m_semanticAnalyzer(new SemanticAnalyzer),
     m_lexicalAnalyzer(new LexicalAnalyzer),
-    m_threeAddressCodeGenerator(new ThreeAddressCodeGenerator)
+    m_threeAddressCodeGenerator(new ThreeAddressCodeGenerator),
+    m_isTranslatedSourceCodeAnalyzed(false)
 {}
 
 Translator::~Translator()
@@ -28,26 +32,62 @@ void Translator::translate(const QString &code)
 {
     this->prepare();
 
-    m_lexicalAnalyzer->analyze(code);
-    m_lexicalAnalyzerComplete = m_lexicalAnalyzer->errorText().isEmpty();
+    // Settings which were changed after analysis are compiled again by analysis
+    bool isAnalyzed = m_isTranslatedSourceCodeAnalyzed
+            && m_lexicalAnalyzer->isTransitionTableCompiled()
+            && m_syntacticAnalyzer->isParseTableBuilt()
+            && (m_lexicalAnalyzer->tokenStream().sourceCode() == code);
+    if (!isAnalyzed) {
+        m_lexicalAnalyzer->analyze(code);
+        m_syntacticAnalyzer->analyze(m_lexicalAnalyzer->tokenStream());
+        m_isTranslatedSourceCodeAnalyzed = true;
+    }
+    this->translateTokens();
+}
+
+void Translator::translateFile(const QString &fileName)
+{
+    this->prepare();
+    m_lexicalAnalyzer->analyzeFile(fileName);
+    m_syntacticAnalyzer->analyze(m_lexicalAnalyzer->tokenStream());
+    m_isTranslatedSourceCodeAnalyzed = true;
+    this->translateTokens();
+}
+
+void Translator::retranslate(int position, int charsRemoved, const QString &addedText)
+{
+    m_lexicalAnalyzer->reanalyze(position, charsRemoved, addedText);
+    if (m_isTranslatedSourceCodeAnalyzed) {
+        m_syntacticAnalyzer->reanalyze(m_lexicalAnalyzer->tokenStream(),
+                                       m_lexicalAnalyzer->changedTokenIndex(),
+                                       m_lexicalAnalyzer->removedTokenCount(),
+                                       m_lexicalAnalyzer->addedTokenCount());
+    } else {
+        m_syntacticAnalyzer->analyze(m_lexicalAnalyzer->tokenStream());
+        m_isTranslatedSourceCodeAnalyzed = true;
+    }
+}
+
+void Translator::translateTokens()
+{
+    m_lexicalAnalyzerComplete = !m_lexicalAnalyzer->hasErrors();
     if (m_lexicalAnalyzerComplete)
-        emit setTokenList(MakeStringRepresentation(m_lexicalAnalyzer->tokenList()));
+        emit setTokenList(MakeStringRepresentation(m_lexicalAnalyzer->tokenStream()));
 
-    m_syntacticAnalyzer->analyze(m_lexicalAnalyzer->getTokenListWithoutSpaces());
-    m_syntacticAnalyzerComplete = m_syntacticAnalyzer->errorText().isEmpty();
+    m_syntacticAnalyzerComplete = m_syntacticAnalyzer->diagnostics().isEmpty();
     if (m_syntacticAnalyzerComplete)
-        emit setRuleList(m_syntacticAnalyzer->usedRuleList());
+        emit setUsedRules(m_syntacticAnalyzer);
 
     if (m_lexicalAnalyzerComplete && m_syntacticAnalyzerComplete) {
-        QList<Token> tokenList = m_lexicalAnalyzer->tokenList();
+        TokenStream tokenStream = m_lexicalAnalyzer->tokenStream();
 
-        m_semanticAnalyzer->analyze(tokenList);
-        m_semanticAnalyzerComplete = m_semanticAnalyzer->errorText().isEmpty();
+        m_semanticAnalyzer->analyze(tokenStream, m_syntacticAnalyzer->syntaxTree());
+        m_semanticAnalyzerComplete = m_semanticAnalyzer->diagnostics().isEmpty();
         if (m_semanticAnalyzerComplete)
             emit setBlockTree(m_semanticAnalyzer->mainBlock());
 
-        m_threeAddressCodeGenerator->generate(tokenList);
-        m_threeAddressCodeGeneratorComplete = m_threeAddressCodeGenerator->errorText().isEmpty();
+        m_threeAddressCodeGenerator->generate(tokenStream, m_syntacticAnalyzer->syntaxTree());
+        m_threeAddressCodeGeneratorComplete = m_threeAddressCodeGenerator->diagnostics().isEmpty();
         if (m_threeAddressCodeGeneratorComplete)
             emit setThreeAddressCode(m_threeAddressCodeGenerator->threeAddressCode());
     }
@@ -55,6 +95,42 @@ void Translator::translate(const QString &code)
     emit addToLog(m_HTMLMarkupGenerator->getMessageForLog(this));
 }
 
+void Translator::logGrammarDiagnostics()
+{
+    if (!m_syntacticAnalyzer->isParseTableBuilt())
+        m_syntacticAnalyzer->buildParseTable();
+    if (!m_syntacticAnalyzer->grammarDiagnostics().isEmpty())
+        emit addToLog(m_HTMLMarkupGenerator->getGrammarMessageForLog(m_syntacticAnalyzer));
+}
+
+DiagnosticList Translator::checkFileSyntax(const QString &fileName)
+{
+    this->prepare();
+    m_isTranslatedSourceCodeAnalyzed = false;
+
+    DiagnosticList diagnostics;
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        diagnostics.append(ErrorGenerator::fileOpenError(fileName));
+        return diagnostics;
+    }
+
+    // Analysis keeps only stack of symbols, which depends on nesting of statements
+    TokenCursor tokenCursor(m_lexicalAnalyzer, &file);
+    tokenCursor.setSpacesSkipped(true);
+    const bool isSyntaxTreeEnabled = m_syntacticAnalyzer->isSyntaxTreeEnabled();
+    const bool isTracingEnabled = m_syntacticAnalyzer->isTracingEnabled();
+    m_syntacticAnalyzer->setSyntaxTreeEnabled(false);
+    m_syntacticAnalyzer->setTracingEnabled(false);
+    m_syntacticAnalyzer->analyze(tokenCursor);
+    m_syntacticAnalyzer->setSyntaxTreeEnabled(isSyntaxTreeEnabled);
+    m_syntacticAnalyzer->setTracingEnabled(isTracingEnabled);
+
+    diagnostics.append(tokenCursor.diagnostics());
+    diagnostics.append(m_syntacticAnalyzer->diagnostics());
+    return diagnostics;
+}
+
 void Translator::prepare()
 {
     m_lexicalAnalyzerComplete = false;
@@ -106,7 +182,9 @@ SyntacticAnalyzer *Translator::syntacticAnalyzer() const
 QString Translator::getMarkedUpSourceCode(QString inputCode)
 {
     m_lexicalAnalyzer->analyze(inputCode);
+    m_isTranslatedSourceCodeAnalyzed = false;
     return m_HTMLMarkupGenerator->getSourceCodeHTMLMarkup(m_lexicalAnalyzer);
 }
 
 
+
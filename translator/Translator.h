@@ -8,6 +8,7 @@ class LexicalAnalyzer;
 class ThreeAddressCodeGenerator;
 class HTMLMarkupGenerator;
 class Block;
+class DiagnosticList;
 
 class Translator : public QObject
 {
@@ -33,22 +34,69 @@ public:
     SemanticAnalyzer *semanticAnalyzer() const;
     ThreeAddressCodeGenerator *threeAddressCodeGenerator() const;
 
+    /*!
+     * This method used to write conflicts of loaded production rules to log. Nothing is written if rules are LL(1).
+     */
+    void logGrammarDiagnostics();
+
+    /*!
+     * This method used to check syntax of source code file which may not fit in memory. File is read line by
+     * line and tokens are parsed one by one, token stream, syntax tree and used rules are not stored. Results
+     * of last translation are not kept.
+     *
+     * @param[in] fileName Source code file name.
+     * @return Lexical and syntactic errors. Empty list means that syntax is correct.
+     */
+    DiagnosticList checkFileSyntax(const QString &fileName);
+
 signals:
 
     void addToLog(const QString &log);
     void setTokenList(const QString &tokenList);
-    void setRuleList(const QStringList &ruleList);
+    void setUsedRules(SyntacticAnalyzer *syntacticAnalyzer);
     void setBlockTree(Block *block);
     void setThreeAddressCode(const QString &code);
 
 public slots:
 
+    /*!
+     * This method used to translate source code. Lexical and syntactic analysis are not made again
+     * when source code was analyzed by retranslate() and was not changed after it.
+     *
+     * @param[in] code Source code.
+     */
     void translate(const QString &code);
 
+    /*!
+     * This method used to translate source code file. File is mapped to memory and lexical analyzer scans
+     * its UTF-8 bytes, so source code is not read to QString.
+     *
+     * @param[in] fileName Source code file name.
+     */
+    void translateFile(const QString &fileName);
+
+    /*!
+     * This method used to analyze source code while it is edited. Change is applied to last analyzed
+     * source code, only changed lines are analyzed again by lexical analyzer and only statement or block
+     * which contains them is parsed again. Results are not sent, translate() sends them without analyzing
+     * source code again.
+     *
+     * @param[in] position Index of first changed character.
+     * @param[in] charsRemoved Count of removed characters.
+     * @param[in] addedText Added characters.
+     */
+    void retranslate(int position, int charsRemoved, const QString &addedText);
+
 private:
 
     void prepare();
 
+    /*!
+     * This method used to make semantic analysis and code generation after lexical and syntactic analysis
+     * and to send results.
+     */
+    void translateTokens();
+
     SyntacticAnalyzer *m_syntacticAnalyzer;
     SemanticAnalyzer *m_semanticAnalyzer;
     LexicalAnalyzer *m_lexicalAnalyzer;
@@ -60,6 +108,8 @@ private:
     bool m_semanticAnalyzerComplete;
     bool m_threeAddressCodeGeneratorComplete;
 
+    bool m_isTranslatedSourceCodeAnalyzed;  //!< Is token stream of lexical analyzer parsed by syntactic analyzer.
+
 };
 
 #endif // TRANSLATOR_H
@@ -0,0 +1,56 @@
+#include "Utf8SourceCode.h"
+#include <limits>
+
+Utf8SourceCode::Utf8SourceCode()
+{}
+
+bool Utf8SourceCode::load(const QString &fileName)
+{
+    this->clear();
+    QSharedPointer<QFile> file(new QFile(fileName));
+    if (!file->open(QIODevice::ReadOnly))
+        return false;
+    if (file->size() > std::numeric_limits<int>::max())
+        return false;
+    if (file->size() == 0)
+        return true;
+
+    const uchar *mapping = file->map(0, file->size());
+    if (mapping) {
+        m_file = file;
+        m_bytes = QByteArray::fromRawData(reinterpret_cast<const char *>(mapping), int(file->size()));
+    } else {
+        // e.g. file on device which can't be mapped
+        m_bytes = file->readAll();
+    }
+    return true;
+}
+
+void Utf8SourceCode::clear()
+{
+    // Bytes refer to mapping, so they are cleared first
+    m_bytes.clear();
+    m_file.clear();
+}
+
+const char *Utf8SourceCode::data() const
+{
+    return m_bytes.constData();
+}
+
+int Utf8SourceCode::length() const
+{
+    return m_bytes.length();
+}
+
+int Utf8SourceCode::beginIndex() const
+{
+    if (m_bytes.startsWith("\xEF\xBB\xBF"))
+        return 3;
+    return 0;
+}
+
+QString Utf8SourceCode::toString() const
+{
+    return QString::fromUtf8(m_bytes.constData() + this->beginIndex(), m_bytes.length() - this->beginIndex());
+}
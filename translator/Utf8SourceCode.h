@@ -0,0 +1,56 @@
+#ifndef UTF8SOURCECODE_H
+#define UTF8SOURCECODE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QSharedPointer>
+#include <QFile>
+
+/*!
+ * @brief This class used to store source code as UTF-8 bytes of file.
+ *
+ * File is mapped to memory read-only, so source code is not copied to heap and is not decoded to UTF-16.
+ * Mapping is shared by copies and is removed when last copy is destroyed.
+ */
+class Utf8SourceCode
+{
+
+public:
+
+    Utf8SourceCode();
+
+    /*!
+     * This method used to map file. If file can't be mapped it is read to memory.
+     *
+     * @param[in] fileName File name.
+     * @return If file was opened returns true other returns false.
+     */
+    bool load(const QString &fileName);
+
+    void clear();
+
+    const char *data() const;
+    int length() const;
+
+    /*!
+     * This method returns index of first source code character. It is not 0 when file begins with byte order mark.
+     *
+     * @return Index of first character.
+     */
+    int beginIndex() const;
+
+    /*!
+     * This method used to decode source code to UTF-16.
+     *
+     * @return Source code.
+     */
+    QString toString() const;
+
+private:
+
+    QSharedPointer<QFile> m_file;       //!< Mapped file, NULL when source code was read to memory.
+    QByteArray m_bytes;                 //!< Bytes of source code. Raw data of mapping when file is mapped.
+
+};
+
+#endif // UTF8SOURCECODE_H